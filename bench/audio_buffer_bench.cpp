@@ -0,0 +1,78 @@
+// Throughput of the lock-free capture ring at callback-realistic block sizes.
+// Block sizes are total samples (frames * channels): 64 and 256 cover
+// low-latency callbacks, 1024 covers the conversion scratch block, 4800
+// covers a 50ms stereo callback at 48kHz.
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include <viam/sdk/common/audio.hpp>
+#include "audio_stream.hpp"
+#include "bench_utils.hpp"
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int NUM_CHANNELS = 2;
+
+audio::InputStreamContext make_context() {
+    const viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, SAMPLE_RATE, NUM_CHANNELS};
+    return audio::InputStreamContext(info, audio::BUFFER_DURATION_SECONDS);
+}
+
+void BM_RingWrite(benchmark::State& state) {
+    const size_t block_samples = state.range(0);
+    auto ctx = make_context();
+    std::vector<int16_t> block(block_samples);
+    bench_utils::fill_sine(block, SAMPLE_RATE, NUM_CHANNELS);
+
+    for (auto _ : state) {
+        ctx.write_samples(block.data(), block.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(block_samples) * sizeof(int16_t));
+}
+BENCHMARK(BM_RingWrite)->Arg(64)->Arg(256)->Arg(1024)->Arg(4800);
+
+void BM_RingRead(benchmark::State& state) {
+    const int block_samples = static_cast<int>(state.range(0));
+    auto ctx = make_context();
+
+    // Fill the ring completely so every read position is valid
+    std::vector<int16_t> fill(ctx.buffer_capacity);
+    bench_utils::fill_sine(fill, SAMPLE_RATE, NUM_CHANNELS);
+    ctx.write_samples(fill.data(), fill.size());
+
+    std::vector<int16_t> out(block_samples);
+    uint64_t position = 0;
+    for (auto _ : state) {
+        if (position + block_samples > static_cast<uint64_t>(ctx.buffer_capacity)) {
+            position = 0;
+        }
+        const int read = ctx.read_samples(out.data(), block_samples, position);
+        benchmark::DoNotOptimize(read);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(block_samples) * sizeof(int16_t));
+}
+BENCHMARK(BM_RingRead)->Arg(64)->Arg(256)->Arg(1024)->Arg(4800);
+
+// Interleaved producer/consumer pattern on one thread - approximates the
+// callback writing a block and a get_audio session immediately draining it
+void BM_RingWriteRead(benchmark::State& state) {
+    const int block_samples = static_cast<int>(state.range(0));
+    auto ctx = make_context();
+    std::vector<int16_t> block(block_samples);
+    bench_utils::fill_sine(block, SAMPLE_RATE, NUM_CHANNELS);
+    std::vector<int16_t> out(block_samples);
+
+    uint64_t position = 0;
+    for (auto _ : state) {
+        ctx.write_samples(block.data(), block.size());
+        const int read = ctx.read_samples(out.data(), block_samples, position);
+        benchmark::DoNotOptimize(read);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(block_samples) * 2 * sizeof(int16_t));
+}
+BENCHMARK(BM_RingWriteRead)->Arg(64)->Arg(256)->Arg(1024)->Arg(4800);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+// Throughput of the PCM conversion kernels and the RMS pass across buffer
+// sizes from one callback block (1Ki samples) to one coalesced catch-up
+// chunk (64Ki samples). Bytes/sec is measured over the input data.
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "audio_codec.hpp"
+#include "bench_utils.hpp"
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int NUM_CHANNELS = 2;
+
+std::vector<int16_t> make_pcm16(size_t sample_count) {
+    std::vector<int16_t> samples(sample_count);
+    bench_utils::fill_sine(samples, SAMPLE_RATE, NUM_CHANNELS);
+    return samples;
+}
+
+void BM_ConvertPcm32ToPcm16(benchmark::State& state) {
+    const size_t sample_count = state.range(0);
+    const auto pcm16 = make_pcm16(sample_count);
+    std::vector<uint8_t> input(sample_count * sizeof(int32_t));
+    auto* in32 = reinterpret_cast<int32_t*>(input.data());
+    for (size_t i = 0; i < sample_count; i++) {
+        in32[i] = static_cast<int32_t>(pcm16[i]) << 16;
+    }
+
+    std::vector<uint8_t> output;
+    for (auto _ : state) {
+        audio::codec::convert_pcm32_to_pcm16(input.data(), static_cast<int>(input.size()), output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_ConvertPcm32ToPcm16)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+void BM_ConvertFloat32ToPcm16(benchmark::State& state) {
+    const size_t sample_count = state.range(0);
+    const auto pcm16 = make_pcm16(sample_count);
+    std::vector<uint8_t> input(sample_count * sizeof(float));
+    auto* in_float = reinterpret_cast<float*>(input.data());
+    for (size_t i = 0; i < sample_count; i++) {
+        in_float[i] = static_cast<float>(pcm16[i]) / 32768.0f;
+    }
+
+    std::vector<uint8_t> output;
+    for (auto _ : state) {
+        audio::codec::convert_float32_to_pcm16(input.data(), static_cast<int>(input.size()), output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_ConvertFloat32ToPcm16)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+// The three real-time capture-callback kernels (fixed output scratch,
+// no allocation), as run when capture_format negotiates a wide format
+
+void BM_ConvertInt32Samples(benchmark::State& state) {
+    const size_t sample_count = state.range(0);
+    const auto pcm16 = make_pcm16(sample_count);
+    std::vector<int32_t> input(sample_count);
+    for (size_t i = 0; i < sample_count; i++) {
+        input[i] = static_cast<int32_t>(pcm16[i]) << 16;
+    }
+
+    std::vector<int16_t> output(sample_count);
+    for (auto _ : state) {
+        audio::codec::convert_int32_to_pcm16(input.data(), output.data(), sample_count);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sample_count) * sizeof(int32_t));
+}
+BENCHMARK(BM_ConvertInt32Samples)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+void BM_ConvertInt24Samples(benchmark::State& state) {
+    const size_t sample_count = state.range(0);
+    const auto pcm16 = make_pcm16(sample_count);
+    std::vector<uint8_t> input(sample_count * 3);
+    for (size_t i = 0; i < sample_count; i++) {
+        input[i * 3] = 0;
+        input[i * 3 + 1] = static_cast<uint8_t>(pcm16[i] & 0xFF);
+        input[i * 3 + 2] = static_cast<uint8_t>((pcm16[i] >> 8) & 0xFF);
+    }
+
+    std::vector<int16_t> output(sample_count);
+    for (auto _ : state) {
+        audio::codec::convert_int24_to_pcm16(input.data(), output.data(), sample_count);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_ConvertInt24Samples)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+void BM_ConvertFloat32Samples(benchmark::State& state) {
+    const size_t sample_count = state.range(0);
+    const auto pcm16 = make_pcm16(sample_count);
+    std::vector<float> input(sample_count);
+    for (size_t i = 0; i < sample_count; i++) {
+        input[i] = static_cast<float>(pcm16[i]) / 32768.0f;
+    }
+
+    std::vector<int16_t> output(sample_count);
+    for (auto _ : state) {
+        audio::codec::convert_float32_to_pcm16_samples(input.data(), output.data(), sample_count);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sample_count) * sizeof(float));
+}
+BENCHMARK(BM_ConvertFloat32Samples)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+// Per-chunk energy pass used by the silence gate
+void BM_ComputeRms(benchmark::State& state) {
+    const size_t sample_count = state.range(0);
+    const auto samples = make_pcm16(sample_count);
+
+    for (auto _ : state) {
+        const double rms = audio::codec::compute_rms(samples.data(), static_cast<int>(sample_count));
+        benchmark::DoNotOptimize(rms);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sample_count) * sizeof(int16_t));
+}
+BENCHMARK(BM_ComputeRms)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace bench_utils {
+
+// Fills buffer with an interleaved 440Hz sine so codec benchmarks exercise
+// realistic (non-constant) sample data
+inline void fill_sine(std::vector<int16_t>& buffer, int sample_rate, int num_channels, double frequency_hz = 440.0) {
+    const size_t num_frames = buffer.size() / num_channels;
+    for (size_t frame = 0; frame < num_frames; frame++) {
+        const double t = static_cast<double>(frame) / sample_rate;
+        const auto sample = static_cast<int16_t>(std::sin(2.0 * M_PI * frequency_hz * t) * 16000.0);
+        for (int ch = 0; ch < num_channels; ch++) {
+            buffer[frame * num_channels + ch] = sample;
+        }
+    }
+}
+
+}  // namespace bench_utils
@@ -0,0 +1,74 @@
+// LAME encode per frame-aligned chunk and full-clip MP3 decode throughput.
+// Bytes/sec is measured over the PCM side of each operation, so encode and
+// decode numbers are directly comparable to the raw capture data rate.
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "bench_utils.hpp"
+#include "mp3_decoder.hpp"
+#include "mp3_encoder.hpp"
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+
+// Builds a frame-aligned sine chunk of roughly 150ms for the given encoder
+std::vector<int16_t> make_aligned_chunk(const microphone::MP3EncoderContext& ctx, int num_channels) {
+    const int frame_samples = ctx.frame_size * num_channels;
+    const int target_samples = SAMPLE_RATE * num_channels * 150 / 1000;
+    const int num_frames = std::max(1, target_samples / frame_samples);
+    std::vector<int16_t> chunk(static_cast<size_t>(num_frames) * frame_samples);
+    bench_utils::fill_sine(chunk, SAMPLE_RATE, num_channels);
+    return chunk;
+}
+
+void BM_Mp3EncodeChunk(benchmark::State& state) {
+    const int num_channels = static_cast<int>(state.range(0));
+    microphone::MP3EncoderContext ctx;
+    microphone::initialize_mp3_encoder(ctx, SAMPLE_RATE, num_channels);
+    auto chunk = make_aligned_chunk(ctx, num_channels);
+
+    std::vector<uint8_t> output;
+    uint64_t position = 0;
+    for (auto _ : state) {
+        output.clear();
+        microphone::encode_samples_to_mp3(ctx, chunk.data(), static_cast<int>(chunk.size()), position, output);
+        position += chunk.size();
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(chunk.size()) * sizeof(int16_t));
+    microphone::cleanup_mp3_encoder(ctx);
+}
+BENCHMARK(BM_Mp3EncodeChunk)->Arg(1)->Arg(2);
+
+void BM_Mp3DecodeClip(benchmark::State& state) {
+    const int num_channels = static_cast<int>(state.range(0));
+
+    // Fixture clip: one second of sine encoded up front, outside the timed loop
+    microphone::MP3EncoderContext enc_ctx;
+    microphone::initialize_mp3_encoder(enc_ctx, SAMPLE_RATE, num_channels);
+    std::vector<int16_t> pcm(static_cast<size_t>(SAMPLE_RATE) * num_channels);
+    bench_utils::fill_sine(pcm, SAMPLE_RATE, num_channels);
+    std::vector<uint8_t> encoded;
+    microphone::encode_samples_to_mp3(enc_ctx, pcm.data(), static_cast<int>(pcm.size()), 0, encoded);
+    microphone::flush_mp3_encoder(enc_ctx, encoded);
+    microphone::cleanup_mp3_encoder(enc_ctx);
+
+    std::vector<uint8_t> decoded;
+    int64_t decoded_bytes = 0;
+    for (auto _ : state) {
+        // Fresh decoder per iteration, matching how each play call decodes
+        speaker::MP3DecoderContext dec_ctx;
+        decoded.clear();
+        speaker::decode_mp3_to_pcm16(dec_ctx, encoded, decoded);
+        decoded_bytes += static_cast<int64_t>(decoded.size());
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetBytesProcessed(decoded_bytes);
+}
+BENCHMARK(BM_Mp3DecodeClip)->Arg(1)->Arg(2);
+
+}  // namespace
+
+BENCHMARK_MAIN();
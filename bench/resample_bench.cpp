@@ -0,0 +1,40 @@
+// Streaming soxr resampler throughput at the rate pairs deployments actually
+// run (device rate down to the 16kHz speech models consume), fed a 150ms
+// chunk per iteration - the same cadence as a get_audio session.
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "bench_utils.hpp"
+#include "resample.hpp"
+
+namespace {
+
+void BM_ResampleChunk(benchmark::State& state) {
+    const int input_rate = static_cast<int>(state.range(0));
+    const int output_rate = static_cast<int>(state.range(1));
+    const int num_channels = static_cast<int>(state.range(2));
+
+    audio::Resampler resampler(input_rate, output_rate, num_channels);
+
+    // 150ms chunk at the input rate, matching the get_audio chunk target
+    const size_t chunk_samples = static_cast<size_t>(input_rate) * num_channels * 150 / 1000;
+    std::vector<int16_t> input(chunk_samples);
+    bench_utils::fill_sine(input, input_rate, num_channels);
+
+    std::vector<int16_t> output;
+    for (auto _ : state) {
+        resampler.process(input.data(), input.size(), output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(chunk_samples) * sizeof(int16_t));
+}
+BENCHMARK(BM_ResampleChunk)
+    ->Args({44100, 16000, 1})
+    ->Args({44100, 16000, 2})
+    ->Args({48000, 16000, 1})
+    ->Args({48000, 16000, 2})
+    ->Args({48000, 44100, 2});
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -45,6 +45,7 @@ class audio(ConanFile):
         self.requires("viam-cpp-sdk/0.21.0")
         self.requires("libmp3lame/3.100")
         self.requires("soxr/0.1.3")
+        self.requires("opus/1.4")
 
     def generate(self):
         tc = CMakeToolchain(self)
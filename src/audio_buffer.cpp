@@ -1,18 +1,76 @@
 #include "audio_buffer.hpp"
 #include <atomic>
 #include <chrono>
+#include <cstring>
 #include <mutex>
 #include <vector>
 #include <viam/sdk/common/audio.hpp>
 #include <viam/sdk/components/audio_in.hpp>
+#include "pcm_convert.hpp"
 #include "portaudio.h"
 
 namespace audio {
 
 namespace vsdk = ::viam::sdk;
 
+namespace {
+
+// Shared positioning, overrun, and torn-read handling for the fused
+// read+convert kernels - the same seqlock protocol as read_samples, with a
+// per-segment conversion in place of the memcpy. convert(out_offset, src,
+// count) writes count converted samples starting at output sample out_offset.
+template <typename ConvertSegment>
+int read_converted(AudioBuffer& ring, int sample_count, uint64_t& read_position, ConvertSegment&& convert) noexcept {
+    const uint64_t current_write_pos = ring.total_samples_written.load(std::memory_order_acquire);
+
+    if (read_position > current_write_pos) {
+        VIAM_SDK_LOG(warn) << "Read position " << read_position << " is ahead of write position " << current_write_pos
+                           << " - no samples available to read";
+        return 0;
+    }
+
+    if (current_write_pos > read_position + ring.buffer_capacity) {
+        const uint64_t old_position = read_position;
+        read_position = current_write_pos - ring.buffer_capacity;
+        VIAM_SDK_LOG(warn) << "Audio buffer overrun: read position " << old_position
+                           << " has been overwritten. Skipping to oldest available sample at " << read_position << " (lost "
+                           << (read_position - old_position) << " samples)";
+    }
+
+    const uint64_t available = current_write_pos - read_position;
+    const int to_read = std::min(static_cast<uint64_t>(sample_count), available);
+
+    // Convert out in at most two contiguous segments (read may wrap around the ring end)
+    const size_t index = read_position % ring.buffer_capacity;
+    const size_t first_segment = std::min(static_cast<size_t>(to_read), static_cast<size_t>(ring.buffer_capacity) - index);
+    convert(0, &ring.audio_buffer[index], first_segment);
+    if (first_segment < static_cast<size_t>(to_read)) {
+        convert(first_segment, &ring.audio_buffer[0], to_read - first_segment);
+    }
+
+    // Seqlock-style validation, mirroring read_samples: the writer reserves
+    // the region before copying into it, so validating against the
+    // reservation counter behind an acquire fence catches both a completed
+    // lap and an overwrite still in progress. The fence orders the
+    // conversion's loads before the validation load.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t reserved_after = ring.total_samples_reserved.load(std::memory_order_relaxed);
+    if (reserved_after > read_position + ring.buffer_capacity) {
+        const uint64_t old_position = read_position;
+        read_position = reserved_after - ring.buffer_capacity;
+        VIAM_SDK_LOG(warn) << "Audio buffer overrun during read: samples at position " << old_position
+                           << " were overwritten mid-copy. Skipping to oldest available sample at " << read_position;
+        return 0;
+    }
+
+    read_position += to_read;
+    return to_read;
+}
+
+}  // namespace
+
 AudioBuffer::AudioBuffer(const vsdk::audio_info& audio_info, int buffer_duration_seconds)
-    : audio_buffer(nullptr), buffer_capacity(0), info(audio_info), total_samples_written(0) {
+    : info(audio_info), buffer_capacity(0), audio_buffer(nullptr), total_samples_written(0), total_samples_reserved(0) {
     if (audio_info.sample_rate_hz <= 0) {
         VIAM_SDK_LOG(error) << "[AudioBuffer] sample_rate_hz must be positive, got: " << audio_info.sample_rate_hz;
         throw std::invalid_argument("sample_rate_hz must be positive");
@@ -34,31 +92,56 @@ AudioBuffer::AudioBuffer(const vsdk::audio_info& audio_info, int buffer_duration
         throw std::invalid_argument("buffer_capacity must be positive");
     }
 
-    try {
-        audio_buffer = std::make_unique<std::atomic<int16_t>[]>(buffer_capacity);
-    } catch (const std::bad_alloc& e) {
-        VIAM_SDK_LOG(error) << "[AudioBuffer] Failed to allocate audio buffer of size " << buffer_capacity << " samples: " << e.what();
-        throw std::runtime_error("Failed to allocate audio buffer of size " + std::to_string(buffer_capacity) + " samples: " + e.what());
-    }
-
-    // Initialize all elements to 0
-    for (int i = 0; i < buffer_capacity; i++) {
-        audio_buffer[i].store(0);
+    // calloc rather than value-initialized new[]: large zeroed allocations are
+    // served straight from zero pages, so a 60-second ring costs the same to
+    // construct as a 1-second one
+    audio_buffer.reset(static_cast<int16_t*>(std::calloc(buffer_capacity, sizeof(int16_t))));
+    if (!audio_buffer) {
+        VIAM_SDK_LOG(error) << "[AudioBuffer] Failed to allocate audio buffer of size " << buffer_capacity << " samples";
+        throw std::runtime_error("Failed to allocate audio buffer of size " + std::to_string(buffer_capacity) + " samples");
     }
 }
 
 void AudioBuffer::write_sample(int16_t sample) noexcept {
-    // Find current index of circular buffer
-    uint64_t pos = total_samples_written.load();
-    int index = pos % buffer_capacity;
+    write_samples(&sample, 1);
+}
+
+void AudioBuffer::write_samples(const int16_t* samples, size_t sample_count) noexcept {
+    if (samples == nullptr || sample_count == 0) {
+        return;
+    }
+
+    // If a single write is larger than the whole ring, only the last
+    // buffer_capacity samples are retained
+    if (sample_count > static_cast<size_t>(buffer_capacity)) {
+        samples += sample_count - buffer_capacity;
+        sample_count = buffer_capacity;
+    }
 
-    audio_buffer[index].store(sample);
+    const uint64_t pos = total_samples_written.load(std::memory_order_relaxed);
+    const size_t index = pos % buffer_capacity;
+
+    // Reserve the region before touching it. The release fence keeps the data
+    // stores below from being observed before the reservation, so a reader
+    // that copied out of this region mid-overwrite will see the advanced
+    // reservation in its post-copy validation and discard the torn data.
+    total_samples_reserved.store(pos + sample_count, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Copy in at most two contiguous segments (write may wrap around the ring end)
+    const size_t first_segment = std::min(sample_count, static_cast<size_t>(buffer_capacity) - index);
+    std::memcpy(&audio_buffer[index], samples, first_segment * sizeof(int16_t));
+    if (first_segment < sample_count) {
+        std::memcpy(&audio_buffer[0], samples + first_segment, (sample_count - first_segment) * sizeof(int16_t));
+    }
 
-    total_samples_written.fetch_add(1);
+    // Publish the whole block with a single release-store. Readers that acquire
+    // the new position are guaranteed to see the samples copied above.
+    total_samples_written.store(pos + sample_count, std::memory_order_release);
 }
 
 int AudioBuffer::read_samples(int16_t* buffer, int sample_count, uint64_t& read_position) noexcept {
-    uint64_t current_write_pos = total_samples_written.load();
+    const uint64_t current_write_pos = total_samples_written.load(std::memory_order_acquire);
 
     // trying to read position that hasn't been written yet - return zero samples
     if (read_position > current_write_pos) {
@@ -77,12 +160,31 @@ int AudioBuffer::read_samples(int16_t* buffer, int sample_count, uint64_t& read_
                            << (read_position - old_position) << " samples)";
     }
 
-    uint64_t available = current_write_pos - read_position;
-    int to_read = std::min(static_cast<uint64_t>(sample_count), available);
+    const uint64_t available = current_write_pos - read_position;
+    const int to_read = std::min(static_cast<uint64_t>(sample_count), available);
 
-    for (int i = 0; i < to_read; i++) {
-        int index = (read_position + i) % buffer_capacity;
-        buffer[i] = audio_buffer[index].load();
+    // Copy out in at most two contiguous segments (read may wrap around the ring end)
+    const size_t index = read_position % buffer_capacity;
+    const size_t first_segment = std::min(static_cast<size_t>(to_read), static_cast<size_t>(buffer_capacity) - index);
+    std::memcpy(buffer, &audio_buffer[index], first_segment * sizeof(int16_t));
+    if (first_segment < static_cast<size_t>(to_read)) {
+        std::memcpy(buffer + first_segment, &audio_buffer[0], (to_read - first_segment) * sizeof(int16_t));
+    }
+
+    // Seqlock-style validation: if the writer reserved past the region we
+    // just copied, the data may be torn (the reservation advances before the
+    // writer's copy, so an in-progress overwrite is visible here even though
+    // it is not yet published). The acquire fence orders the copy's loads
+    // before the validation load - without it the copy could be satisfied
+    // after validation and return lapped data undetected.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t reserved_after = total_samples_reserved.load(std::memory_order_relaxed);
+    if (reserved_after > read_position + buffer_capacity) {
+        const uint64_t old_position = read_position;
+        read_position = reserved_after - buffer_capacity;
+        VIAM_SDK_LOG(warn) << "Audio buffer overrun during read: samples at position " << old_position
+                           << " were overwritten mid-copy. Skipping to oldest available sample at " << read_position;
+        return 0;
     }
 
     // update to the new position in the stream
@@ -92,7 +194,27 @@ int AudioBuffer::read_samples(int16_t* buffer, int sample_count, uint64_t& read_
     return to_read;
 }
 
+int AudioBuffer::read_into_pcm16(uint8_t* dst, int sample_count, uint64_t& position) noexcept {
+    return read_converted(*this, sample_count, position, [dst](size_t out_offset, const int16_t* src, size_t count) {
+        std::memcpy(dst + out_offset * sizeof(int16_t), src, count * sizeof(int16_t));
+    });
+}
+
+int AudioBuffer::read_into_pcm32(uint8_t* dst, int sample_count, uint64_t& position) noexcept {
+    int32_t* out = reinterpret_cast<int32_t*>(dst);
+    return read_converted(*this, sample_count, position, [out](size_t out_offset, const int16_t* src, size_t count) {
+        codec::convert_pcm16_to_pcm32_samples(src, out + out_offset, count);
+    });
+}
+
+int AudioBuffer::read_into_float32(uint8_t* dst, int sample_count, uint64_t& position) noexcept {
+    float* out = reinterpret_cast<float*>(dst);
+    return read_converted(*this, sample_count, position, [out](size_t out_offset, const int16_t* src, size_t count) {
+        codec::convert_pcm16_to_float32_samples(src, out + out_offset, count);
+    });
+}
+
 uint64_t AudioBuffer::get_write_position() const noexcept {
-    return total_samples_written.load();
+    return total_samples_written.load(std::memory_order_acquire);
 }
 }  // namespace audio
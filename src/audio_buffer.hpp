@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdlib>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <vector>
 #include <viam/sdk/common/audio.hpp>
 #include <viam/sdk/components/audio_in.hpp>
@@ -12,9 +16,56 @@ namespace audio {
 
 namespace vsdk = ::viam::sdk;
 
-constexpr int BUFFER_DURATION_SECONDS = 30;  // How much audio history to keep in buffer
+// Default audio history to keep in the ring when the component config does
+// not set buffer_duration_seconds
+constexpr int BUFFER_DURATION_SECONDS = 30;
 
-// Base class for audio buffering - lock-free circular buffer with atomic operations
+// Deleter for the calloc-backed ring storage
+struct FreeDeleter {
+    void operator()(int16_t* p) const noexcept { std::free(p); }
+};
+
+// Alignment used to keep hot atomics written by the real-time callback thread on
+// their own cache line, away from fields read by consumer threads (false sharing).
+#ifdef __cpp_lib_hardware_interference_size
+constexpr std::size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#else
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+#endif
+
+// Fixed-bucket histogram of intervals between real-time callback invocations.
+// record() is a single relaxed increment into a preallocated bucket, so it is
+// safe to call from the audio callback. Bucket upper bounds are milliseconds;
+// the final bucket catches everything at or above the largest bound. A healthy
+// stream concentrates in the buckets around its callback period - mass
+// migrating into the larger buckets is creeping xrun pressure.
+class CallbackIntervalHistogram {
+   public:
+    static constexpr std::array<uint64_t, 9> BUCKET_UPPER_MS = {1, 2, 5, 10, 20, 50, 100, 200, 500};
+    static constexpr std::size_t NUM_BUCKETS = BUCKET_UPPER_MS.size() + 1;
+
+    void record(uint64_t interval_ns) noexcept {
+        const uint64_t interval_ms = interval_ns / 1'000'000;
+        std::size_t bucket = NUM_BUCKETS - 1;
+        for (std::size_t i = 0; i < BUCKET_UPPER_MS.size(); i++) {
+            if (interval_ms < BUCKET_UPPER_MS[i]) {
+                bucket = i;
+                break;
+            }
+        }
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t bucket_count(std::size_t index) const noexcept { return buckets_[index].load(std::memory_order_relaxed); }
+
+   private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{};
+};
+
+// Base class for audio buffering - lock-free single-producer circular buffer.
+// Samples are stored as plain int16_t and published to readers with a single
+// release-store of the write position per block, so the real-time callback can
+// move whole buffers with memcpy instead of per-sample atomic operations.
 // Can be used by both input (microphone) and output (speaker) models.
 // There is a 1:1 correspondence between AudioBuffer and viam audio resource
 class AudioBuffer {
@@ -25,18 +76,51 @@ class AudioBuffer {
     // Writes an audio sample to the audio buffer
     void write_sample(int16_t sample) noexcept;
 
+    // Writes a block of samples to the audio buffer in at most two contiguous
+    // memcpy segments, publishing the write position once after the copy.
+    // Safe to call from the real-time audio callback (no allocation, no locks).
+    void write_samples(const int16_t* samples, size_t sample_count) noexcept;
+
     // Read sample_count samples from the circular buffer starting at the inputted position
     int read_samples(int16_t* buffer, int sample_count, uint64_t& position) noexcept;
 
+    // Fused read+convert: walk the (at most two) contiguous ring segments and
+    // write the samples directly into the destination in the client's final
+    // sample format, skipping the intermediate int16 staging buffer. dst must
+    // hold sample_count output samples (2, 4, and 4 bytes respectively).
+    // Positioning, overrun, and torn-read semantics match read_samples.
+    int read_into_pcm16(uint8_t* dst, int sample_count, uint64_t& position) noexcept;
+    int read_into_pcm32(uint8_t* dst, int sample_count, uint64_t& position) noexcept;
+    int read_into_float32(uint8_t* dst, int sample_count, uint64_t& position) noexcept;
+
     uint64_t get_write_position() const noexcept;
 
+    // Read-mostly configuration - cold after construction
     vsdk::audio_info info;
+    // Format PortAudio delivers callback buffers in. Ring storage is always
+    // pcm16; the capture callback converts wider formats once on write.
+    PaSampleFormat sample_format = paInt16;
     int buffer_capacity;
-    std::atomic<uint64_t> total_samples_written;
-    std::unique_ptr<std::atomic<int16_t>[]> audio_buffer;
-    // Updated by the audio callback on every invocation. Used by the main thread
-    // to detect if the callback has stopped firing (e.g. due to USB errors).
+    // calloc-backed so large rings come from zero pages - construction cost is
+    // O(1) in the configured history duration instead of a full zeroing pass
+    std::unique_ptr<int16_t[], FreeDeleter> audio_buffer;
+
+    // Producer-written hot fields, updated by the real-time callback on every
+    // invocation. Segregated onto their own cache line so callback stores do not
+    // invalidate the read-mostly fields above on consumer cores.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total_samples_written;
+    // Seqlock reservation counter: advanced to pos + count *before* the
+    // writer's data copy (write_samples), while total_samples_written is
+    // advanced after it. A reader validates its copy against this counter
+    // behind an acquire fence, so an in-progress overwrite of the region it
+    // read is detected even though the overwritten data is not yet published.
+    std::atomic<uint64_t> total_samples_reserved;
+    // Used by the main thread to detect if the callback has stopped firing
+    // (e.g. due to USB errors).
     std::atomic<uint64_t> last_callback_time_ns{0};
+    // Inter-callback interval distribution, recorded by the real-time
+    // callback and read by the stats do_command
+    CallbackIntervalHistogram callback_interval_histogram;
 };
 
 }  // namespace audio
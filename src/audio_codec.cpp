@@ -1,10 +1,21 @@
 #include "audio_codec.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <cstring>
 #include <sstream>
 #include <viam/sdk/components/audio_in.hpp>
 #include "audio_stream.hpp"
+#include "pcm_convert.hpp"
+
+// Vectorized PCM conversion kernels: SSE2 on x86-64 (baseline, no extra build
+// flags needed), NEON on ARM. Each conversion falls back to the scalar loop
+// for the tail and on other architectures.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace audio {
 namespace codec {
@@ -28,9 +39,11 @@ AudioCodec parse_codec(const std::string& codec_str) {
         return AudioCodec::MP3;
     } else if (codec == vsdk::audio_codecs::PCM_16) {
         return AudioCodec::PCM_16;
+    } else if (codec == OPUS_CODEC_NAME) {
+        return AudioCodec::OPUS;
     } else {
         std::ostringstream buffer;
-        buffer << "Unsupported codec: " << codec << ". Supported codecs: pcm16, pcm32, pcm32_float, mp3";
+        buffer << "Unsupported codec: " << codec << ". Supported codecs: pcm16, pcm32, pcm32_float, mp3, opus";
         VIAM_SDK_LOG(error) << buffer.str();
         throw std::invalid_argument(buffer.str());
     }
@@ -44,10 +57,7 @@ void convert_pcm16_to_pcm32(const int16_t* samples, int sample_count, std::vecto
 
     // Convert int16 to int32 (left shift by 16 to preserve volume)
     output.resize(sample_count * sizeof(int32_t));
-    int32_t* out = reinterpret_cast<int32_t*>(output.data());
-    for (int i = 0; i < sample_count; i++) {
-        out[i] = static_cast<int32_t>(samples[i]) << 16;
-    }
+    convert_pcm16_to_pcm32_samples(samples, reinterpret_cast<int32_t*>(output.data()), sample_count);
 }
 
 void convert_pcm16_to_float32(const int16_t* samples, int sample_count, std::vector<uint8_t>& output) {
@@ -58,10 +68,7 @@ void convert_pcm16_to_float32(const int16_t* samples, int sample_count, std::vec
 
     // Convert int16 to float32 (normalize to range -1.0 to 1.0)
     output.resize(sample_count * sizeof(float));
-    float* out = reinterpret_cast<float*>(output.data());
-    for (int i = 0; i < sample_count; i++) {
-        out[i] = static_cast<float>(samples[i]) * audio::INT16_TO_FLOAT_SCALE;
-    }
+    convert_pcm16_to_float32_samples(samples, reinterpret_cast<float*>(output.data()), sample_count);
 }
 
 void copy_pcm16(const int16_t* samples, int sample_count, std::vector<uint8_t>& output) {
@@ -81,13 +88,33 @@ void convert_pcm32_to_pcm16(const uint8_t* input_data, const int byte_count, std
 
     const int sample_count = byte_count / 4;
     output.resize(sample_count * 2);
-
-    for (int i = 0; i < sample_count; i++) {
+    int16_t* out = reinterpret_cast<int16_t*>(output.data());
+
+    int i = 0;
+#if defined(__SSE2__)
+    for (; i + 8 <= sample_count; i += 8) {
+        __m128i lo;
+        __m128i hi;
+        std::memcpy(&lo, input_data + i * 4, sizeof(lo));
+        std::memcpy(&hi, input_data + (i + 4) * 4, sizeof(hi));
+        // >>16 then saturating pack; the shift makes every value fit int16
+        const __m128i packed = _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    for (; i + 8 <= sample_count; i += 8) {
+        int32x4_t lo;
+        int32x4_t hi;
+        std::memcpy(&lo, input_data + i * 4, sizeof(lo));
+        std::memcpy(&hi, input_data + (i + 4) * 4, sizeof(hi));
+        // Narrowing shift: >>16 of an int32 always fits int16
+        vst1q_s16(out + i, vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16)));
+    }
+#endif
+    for (; i < sample_count; i++) {
         int32_t sample32;
         memcpy(&sample32, input_data + i * 4, 4);
-
-        const int16_t sample16 = sample32 >> 16;
-        memcpy(output.data() + i * 2, &sample16, 2);
+        out[i] = static_cast<int16_t>(sample32 >> 16);
     }
 }
 
@@ -98,40 +125,60 @@ void convert_float32_to_pcm16(const uint8_t* input_data, const int byte_count, s
 
     const int sample_count = byte_count / 4;
     output.resize(sample_count * 2);
-
-    for (int i = 0; i < sample_count; i++) {
+    int16_t* out = reinterpret_cast<int16_t*>(output.data());
+
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 min_val = _mm_set1_ps(-1.0f);
+    const __m128 max_val = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(FLOAT_TO_INT16_SCALE);
+    for (; i + 8 <= sample_count; i += 8) {
+        __m128 lo;
+        __m128 hi;
+        std::memcpy(&lo, input_data + i * 4, sizeof(lo));
+        std::memcpy(&hi, input_data + (i + 4) * 4, sizeof(hi));
+        lo = _mm_mul_ps(_mm_max_ps(min_val, _mm_min_ps(max_val, lo)), scale);
+        hi = _mm_mul_ps(_mm_max_ps(min_val, _mm_min_ps(max_val, hi)), scale);
+        // Truncating conversion to match the scalar static_cast
+        const __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    const float32x4_t min_val = vdupq_n_f32(-1.0f);
+    const float32x4_t max_val = vdupq_n_f32(1.0f);
+    for (; i + 8 <= sample_count; i += 8) {
+        float32x4_t lo;
+        float32x4_t hi;
+        std::memcpy(&lo, input_data + i * 4, sizeof(lo));
+        std::memcpy(&hi, input_data + (i + 4) * 4, sizeof(hi));
+        lo = vmulq_n_f32(vmaxq_f32(min_val, vminq_f32(max_val, lo)), FLOAT_TO_INT16_SCALE);
+        hi = vmulq_n_f32(vmaxq_f32(min_val, vminq_f32(max_val, hi)), FLOAT_TO_INT16_SCALE);
+        // vcvtq truncates toward zero, matching the scalar static_cast
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(lo)), vqmovn_s32(vcvtq_s32_f32(hi))));
+    }
+#endif
+    for (; i < sample_count; i++) {
         float f;
         memcpy(&f, input_data + i * 4, 4);
 
         const float clamped = std::max(-1.0f, std::min(1.0f, f));
-        const int16_t s = static_cast<int16_t>(clamped * FLOAT_TO_INT16_SCALE);
-
-        memcpy(output.data() + i * 2, &s, 2);
+        out[i] = static_cast<int16_t>(clamped * FLOAT_TO_INT16_SCALE);
     }
 }
 
-void encode_audio_chunk(AudioCodec codec,
-                        int16_t* samples,
-                        int sample_count,
-                        uint64_t chunk_start_position,
-                        microphone::MP3EncoderContext& mp3_ctx,
-                        std::vector<uint8_t>& output_data) {
-    switch (codec) {
-        case AudioCodec::PCM_16:
-            copy_pcm16(samples, sample_count, output_data);
-            break;
-        case AudioCodec::PCM_32:
-            convert_pcm16_to_pcm32(samples, sample_count, output_data);
-            break;
-        case AudioCodec::PCM_32_FLOAT:
-            convert_pcm16_to_float32(samples, sample_count, output_data);
-            break;
-        case AudioCodec::MP3:
-            microphone::encode_samples_to_mp3(mp3_ctx, samples, sample_count, chunk_start_position, output_data);
-            break;
-        default:
-            throw std::invalid_argument("Unsupported codec for encoding");
+double compute_rms(const int16_t* samples, int sample_count) {
+    if (samples == nullptr || sample_count <= 0) {
+        return 0.0;
     }
+
+    // Sum of squares fits int64 comfortably: 2^30 per sample
+    int64_t sum_squares = 0;
+    for (int i = 0; i < sample_count; i++) {
+        const int32_t s = samples[i];
+        sum_squares += static_cast<int64_t>(s) * s;
+    }
+
+    return std::sqrt(static_cast<double>(sum_squares) / sample_count) / 32768.0;
 }
 
 }  // namespace codec
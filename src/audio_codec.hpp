@@ -3,13 +3,19 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include "audio_buffer.hpp"
 #include "mp3_encoder.hpp"
+#include "opus_encoder.hpp"
 
 namespace audio {
 namespace codec {
 
 // Audio codec types supported by the microphone
-enum class AudioCodec { PCM_16, PCM_32, PCM_32_FLOAT, MP3 };
+enum class AudioCodec { PCM_16, PCM_32, PCM_32_FLOAT, MP3, OPUS };
+
+// Codec string for Opus. The C++ SDK's audio_codecs namespace does not define
+// an Opus constant yet, so the identifier lives here until it does.
+inline const std::string OPUS_CODEC_NAME = "opus";
 
 // Convert string to lowercase
 std::string toLower(std::string s);
@@ -33,14 +39,133 @@ void copy_pcm16(const int16_t* samples, int sample_count, std::vector<uint8_t>&
 void convert_pcm32_to_pcm16(const uint8_t* input_data, int byte_count, std::vector<uint8_t>& output);
 void convert_float32_to_pcm16(const uint8_t* input_data, int byte_count, std::vector<uint8_t>& output);
 
-// Encode audio chunk based on codec type
-// Dispatches to appropriate encoding function based on codec
-void encode_audio_chunk(AudioCodec codec,
-                        int16_t* samples,
-                        int sample_count,
-                        uint64_t chunk_start_position,
-                        microphone::MP3EncoderContext& mp3_ctx,
-                        std::vector<uint8_t>& output_data);
+// Capture-side converters from the device's negotiated native format down to
+// the pcm16 ring format. Called from the real-time audio callback, so they
+// are inline, allocation-free, and noexcept - a plain shift or scale per
+// sample, replacing PortAudio's internal converter.
+
+inline void convert_int32_to_pcm16(const int32_t* input, int16_t* output, size_t sample_count) noexcept {
+    for (size_t i = 0; i < sample_count; i++) {
+        output[i] = static_cast<int16_t>(input[i] >> 16);
+    }
+}
+
+// paInt24 is packed little-endian 3-byte samples; the top two bytes are the
+// pcm16 value
+inline void convert_int24_to_pcm16(const uint8_t* input, int16_t* output, size_t sample_count) noexcept {
+    for (size_t i = 0; i < sample_count; i++) {
+        const uint8_t* sample = input + i * 3;
+        output[i] = static_cast<int16_t>(sample[1] | (sample[2] << 8));
+    }
+}
+
+inline void convert_float32_to_pcm16_samples(const float* input, int16_t* output, size_t sample_count) noexcept {
+    for (size_t i = 0; i < sample_count; i++) {
+        float scaled = input[i] * 32767.0f;
+        if (scaled > 32767.0f) {
+            scaled = 32767.0f;
+        } else if (scaled < -32768.0f) {
+            scaled = -32768.0f;
+        }
+        output[i] = static_cast<int16_t>(scaled);
+    }
+}
+
+// Root-mean-square level of a chunk of PCM16 samples, normalized to [0.0, 1.0]
+// Cheap enough to run on every chunk - used by the silence suppression gate
+double compute_rms(const int16_t* samples, int sample_count);
+
+// Compile-time specialized per-chunk encoder.
+// get_audio selects a specialization once when a session starts, so the
+// steady-state loop carries no codec dispatch: the PCM specializations
+// compile down to a straight-line conversion, and only the MP3
+// specialization touches the encoder context.
+//
+// The PCM specializations additionally expose a fused read path
+// (supports_fused_ring_read / read_from_ring) that converts straight out of
+// the capture ring's contiguous segments into the final output allocation -
+// one pass over the data instead of ring -> staging buffer -> output. The
+// streaming loop uses it whenever nothing needs the intermediate int16 form
+// (no resampler, no silence gate).
+template <AudioCodec Codec>
+struct ChunkEncoder;
+
+template <>
+struct ChunkEncoder<AudioCodec::PCM_16> {
+    static constexpr bool supports_fused_ring_read = true;
+
+    static void encode(microphone::MP3EncoderContext&,
+                       int16_t* samples,
+                       int sample_count,
+                       uint64_t,
+                       std::vector<uint8_t>& output_data) {
+        copy_pcm16(samples, sample_count, output_data);
+    }
+
+    static int read_from_ring(audio::AudioBuffer& ring, uint8_t* dst, int sample_count, uint64_t& position) {
+        return ring.read_into_pcm16(dst, sample_count, position);
+    }
+};
+
+template <>
+struct ChunkEncoder<AudioCodec::PCM_32> {
+    static constexpr bool supports_fused_ring_read = true;
+
+    static void encode(microphone::MP3EncoderContext&,
+                       int16_t* samples,
+                       int sample_count,
+                       uint64_t,
+                       std::vector<uint8_t>& output_data) {
+        convert_pcm16_to_pcm32(samples, sample_count, output_data);
+    }
+
+    static int read_from_ring(audio::AudioBuffer& ring, uint8_t* dst, int sample_count, uint64_t& position) {
+        return ring.read_into_pcm32(dst, sample_count, position);
+    }
+};
+
+template <>
+struct ChunkEncoder<AudioCodec::PCM_32_FLOAT> {
+    static constexpr bool supports_fused_ring_read = true;
+
+    static void encode(microphone::MP3EncoderContext&,
+                       int16_t* samples,
+                       int sample_count,
+                       uint64_t,
+                       std::vector<uint8_t>& output_data) {
+        convert_pcm16_to_float32(samples, sample_count, output_data);
+    }
+
+    static int read_from_ring(audio::AudioBuffer& ring, uint8_t* dst, int sample_count, uint64_t& position) {
+        return ring.read_into_float32(dst, sample_count, position);
+    }
+};
+
+template <>
+struct ChunkEncoder<AudioCodec::MP3> {
+    static constexpr bool supports_fused_ring_read = false;
+
+    static void encode(microphone::MP3EncoderContext& mp3_ctx,
+                       int16_t* samples,
+                       int sample_count,
+                       uint64_t chunk_start_position,
+                       std::vector<uint8_t>& output_data) {
+        microphone::encode_samples_to_mp3(mp3_ctx, samples, sample_count, chunk_start_position, output_data);
+    }
+};
+
+template <>
+struct ChunkEncoder<AudioCodec::OPUS> {
+    static constexpr bool supports_fused_ring_read = false;
+
+    static void encode(microphone::OpusEncoderContext& opus_ctx,
+                       int16_t* samples,
+                       int sample_count,
+                       uint64_t chunk_start_position,
+                       std::vector<uint8_t>& output_data) {
+        microphone::encode_samples_to_opus(opus_ctx, samples, sample_count, chunk_start_position, output_data);
+    }
+};
 
 }  // namespace codec
 }  // namespace audio
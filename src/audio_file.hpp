@@ -0,0 +1,150 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <viam/sdk/common/utils.hpp>
+
+namespace audio {
+namespace file {
+
+// Read-only memory mapping of a local file. Pages are faulted in from the
+// page cache on demand, so streaming through an arbitrarily long file never
+// materializes it in the heap.
+class MappedFile {
+   public:
+    explicit MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            const std::string msg = "[play_file] failed to open " + path + ": " + std::strerror(errno);
+            VIAM_SDK_LOG(error) << msg;
+            throw std::runtime_error(msg);
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const std::string msg = "[play_file] failed to stat " + path + ": " + std::strerror(errno);
+            ::close(fd);
+            VIAM_SDK_LOG(error) << msg;
+            throw std::runtime_error(msg);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            const std::string msg = "[play_file] file is empty: " + path;
+            VIAM_SDK_LOG(error) << msg;
+            throw std::runtime_error(msg);
+        }
+
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            const std::string msg = "[play_file] failed to mmap " + path + ": " + std::strerror(errno);
+            VIAM_SDK_LOG(error) << msg;
+            throw std::runtime_error(msg);
+        }
+        data_ = static_cast<const uint8_t*>(mapping);
+    }
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const noexcept {
+        return data_;
+    }
+    size_t size() const noexcept {
+        return size_;
+    }
+
+   private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Parsed view into a pcm16 WAV file: format plus a pointer directly into the
+// mapped data chunk - nothing is copied.
+struct WavPcm16 {
+    int sample_rate = 0;
+    int num_channels = 0;
+    const int16_t* samples = nullptr;
+    size_t num_samples = 0;
+};
+
+inline uint16_t read_le16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t read_le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline bool is_wav(const uint8_t* data, size_t size) {
+    return size >= 12 && std::memcmp(data, "RIFF", 4) == 0 && std::memcmp(data + 8, "WAVE", 4) == 0;
+}
+
+// Walks the RIFF chunk list for the fmt and data chunks. Only uncompressed
+// 16-bit PCM is supported - anything else should ship as MP3.
+inline WavPcm16 parse_wav_pcm16(const uint8_t* data, size_t size) {
+    if (!is_wav(data, size)) {
+        VIAM_SDK_LOG(error) << "[play_file] not a RIFF/WAVE file";
+        throw std::invalid_argument("[play_file] not a RIFF/WAVE file");
+    }
+
+    WavPcm16 wav;
+    bool have_fmt = false;
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t* chunk_id = data + offset;
+        size_t chunk_size = read_le32(data + offset + 4);
+        offset += 8;
+        // Tolerate a truncated final chunk
+        if (chunk_size > size - offset) {
+            chunk_size = size - offset;
+        }
+
+        if (std::memcmp(chunk_id, "fmt ", 4) == 0 && chunk_size >= 16) {
+            const uint16_t audio_format = read_le16(data + offset);
+            const uint16_t num_channels = read_le16(data + offset + 2);
+            const uint32_t sample_rate = read_le32(data + offset + 4);
+            const uint16_t bits_per_sample = read_le16(data + offset + 14);
+            if (audio_format != 1 || bits_per_sample != 16) {
+                VIAM_SDK_LOG(error) << "[play_file] unsupported WAV format (format=" << audio_format
+                                    << ", bits=" << bits_per_sample << "), only 16-bit PCM is supported";
+                throw std::invalid_argument("[play_file] unsupported WAV format, only 16-bit PCM is supported");
+            }
+            wav.sample_rate = static_cast<int>(sample_rate);
+            wav.num_channels = num_channels;
+            have_fmt = true;
+        } else if (std::memcmp(chunk_id, "data", 4) == 0) {
+            wav.samples = reinterpret_cast<const int16_t*>(data + offset);
+            wav.num_samples = chunk_size / sizeof(int16_t);
+        }
+
+        // Chunks are word-aligned
+        offset += chunk_size + (chunk_size & 1);
+    }
+
+    if (!have_fmt || !wav.samples) {
+        VIAM_SDK_LOG(error) << "[play_file] WAV file missing fmt or data chunk";
+        throw std::invalid_argument("[play_file] WAV file missing fmt or data chunk");
+    }
+    return wav;
+}
+
+}  // namespace file
+}  // namespace audio
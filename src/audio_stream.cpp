@@ -30,6 +30,18 @@ uint64_t InputStreamContext::get_sample_number_from_timestamp(int64_t timestamp)
     return sample_number;
 }
 
+bool InputStreamContext::wait_for_write_position(uint64_t min_write_position, std::chrono::milliseconds timeout) {
+    if (get_write_position() >= min_write_position) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(wait_mu_);
+    return samples_available_cv_.wait_for(lock, timeout, [&] { return get_write_position() >= min_write_position; });
+}
+
+void InputStreamContext::notify_samples_written() noexcept {
+    samples_available_cv_.notify_all();
+}
+
 OutputStreamContext::OutputStreamContext(const vsdk::audio_info& audio_info, int buffer_duration_seconds)
     : AudioBuffer(audio_info, buffer_duration_seconds), playback_position(0) {}
 
@@ -2,11 +2,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <vector>
 #include <viam/sdk/common/audio.hpp>
 #include <viam/sdk/components/audio_in.hpp>
 #include "audio_buffer.hpp"
+#include "pcm_convert.hpp"
 #include "portaudio.h"
 
 namespace audio {
@@ -14,7 +16,6 @@ namespace audio {
 namespace vsdk = ::viam::sdk;
 
 constexpr uint64_t NANOSECONDS_PER_SECOND = 1000000000ULL;
-constexpr float INT16_TO_FLOAT_SCALE = 1.0f / 32768.0f;  // Scale factor for converting int16 samples to float [-1.0, 1.0]
 
 // InputStreamContext manages a circular buffer of audio for microphone input
 // Extends AudioBuffer with timestamp tracking for accurate audio capture metadata
@@ -25,18 +26,40 @@ class InputStreamContext : public AudioBuffer {
     std::chrono::system_clock::time_point stream_start_time;
     double first_sample_adc_time;
     std::atomic<bool> first_callback_captured;
-    std::atomic<uint64_t> input_overflow_count{0};
+    // Written by the real-time callback on xruns, read by get_audio readers.
+    // On their own cache line so callback stores don't contend with the
+    // timestamp anchor fields above, which readers touch on every chunk.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> input_overflow_count{0};
     std::atomic<uint64_t> input_underflow_count{0};
     std::chrono::nanoseconds calculate_sample_timestamp(uint64_t sample_number) noexcept;
     uint64_t get_sample_number_from_timestamp(int64_t timestamp) noexcept;
+
+    // Blocks until the write position reaches min_write_position or the timeout
+    // elapses. Returns true if the threshold was reached. Used by get_audio
+    // readers to sleep until exactly one chunk is available instead of polling.
+    bool wait_for_write_position(uint64_t min_write_position, std::chrono::milliseconds timeout);
+
+    // Wakes threads blocked in wait_for_write_position. Called by the real-time
+    // callback after publishing samples - deliberately does not take wait_mu_
+    // so the callback cannot block on a waiter holding the lock. Waiters
+    // re-check the write position with a bounded wait_for, so a missed wakeup
+    // costs at most one timeout period.
+    void notify_samples_written() noexcept;
+
+    std::mutex wait_mu_;
+    std::condition_variable samples_available_cv_;
 };
 
 // OutputStreamContext manages a circular buffer of audio for speaker output
 // Extends AudioBuffer with playback position tracking
 class OutputStreamContext : public AudioBuffer {
    public:
-    std::atomic<uint64_t> playback_position;
-    std::atomic<uint64_t> output_overflow_count{0};
+    // Advanced by the real-time callback on every invocation and polled by
+    // play() to track completion - the hottest field in this struct, kept on
+    // its own cache line away from the xrun counters below.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> playback_position;
+    // Written by the real-time callback on xruns, read by play() for logging.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> output_overflow_count{0};
     std::atomic<uint64_t> output_underflow_count{0};
     OutputStreamContext(const vsdk::audio_info& audio_info, int buffer_duration_seconds = BUFFER_DURATION_SECONDS);
 };
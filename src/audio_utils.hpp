@@ -5,6 +5,7 @@
 #include <string>
 #include <viam/sdk/components/audio_out.hpp>
 #include "audio_stream.hpp"
+#include "device_registry.hpp"
 #include "portaudio.hpp"
 
 namespace audio {
@@ -35,6 +36,16 @@ struct ConfigParams {
     std::optional<double> latency_ms;
     std::optional<int> historical_throttle_ms;
     std::optional<int> volume;
+    std::optional<bool> silence_suppression;
+    std::optional<double> silence_threshold_rms;
+    std::optional<int> silence_hang_ms;
+    std::optional<int> catchup_max_chunk_bytes;
+    std::optional<int> decoded_cache_bytes;
+    std::string asset_dir;
+    std::string capture_format;
+    std::optional<int> opus_bitrate;
+    std::optional<int> opus_complexity;
+    std::optional<int> buffer_duration_seconds;
 };
 
 // Configuration for opening a PortAudio stream
@@ -47,12 +58,33 @@ struct StreamParams {
     // viable latency instead, rounding up to the next practical value.
     // Use get_stream_latency() after opening the stream to retrieve the actual latency PortAudio selected.
     double suggested_latency_seconds;
+    // Sample format the stream is opened with. Output streams are always
+    // paInt16; input streams negotiate the widest format the device accepts
+    // (see setupStreamFromConfig) so PortAudio never down-converts silently.
+    PaSampleFormat sample_format = paInt16;
     bool is_input;
     PaStreamCallback* callback;
     void* user_data;  // Points to AudioStreamContext* or PlaybackBuffer*
 };
 
-// Helper function to find device by name
+inline const char* sample_format_name(PaSampleFormat format) {
+    switch (format) {
+        case paInt16:
+            return "int16";
+        case paInt24:
+            return "int24";
+        case paInt32:
+            return "int32";
+        case paFloat32:
+            return "float32";
+        default:
+            return "unknown";
+    }
+}
+
+// Helper function to find device by name by scanning the given interface
+// directly. Production stream setup goes through DeviceRegistry::find_by_name
+// instead, which serves the same lookup from the cached enumeration snapshot.
 inline PaDeviceIndex findDeviceByName(const std::string& name, const audio::portaudio::PortAudioInterface& pa) {
     const int deviceCount = pa.getDeviceCount();
     if (deviceCount < 0) {
@@ -101,11 +133,63 @@ inline ConfigParams parseConfigAttributes(const viam::sdk::ResourceConfig& cfg)
         params.volume = static_cast<int>(*attrs.at("volume").get<double>());
     }
 
+    if (attrs.count("silence_suppression")) {
+        params.silence_suppression = *attrs.at("silence_suppression").get<bool>();
+    }
+
+    if (attrs.count("silence_threshold_rms")) {
+        params.silence_threshold_rms = *attrs.at("silence_threshold_rms").get<double>();
+    }
+
+    if (attrs.count("silence_hang_ms")) {
+        params.silence_hang_ms = static_cast<int>(*attrs.at("silence_hang_ms").get<double>());
+    }
+
+    if (attrs.count("catchup_max_chunk_bytes")) {
+        params.catchup_max_chunk_bytes = static_cast<int>(*attrs.at("catchup_max_chunk_bytes").get<double>());
+    }
+
+    if (attrs.count("decoded_cache_bytes")) {
+        params.decoded_cache_bytes = static_cast<int>(*attrs.at("decoded_cache_bytes").get<double>());
+    }
+
+    if (attrs.count("asset_dir")) {
+        params.asset_dir = *attrs.at("asset_dir").get<std::string>();
+    }
+
+    if (attrs.count("capture_format")) {
+        params.capture_format = *attrs.at("capture_format").get<std::string>();
+    }
+
+    if (attrs.count("opus_bitrate")) {
+        params.opus_bitrate = static_cast<int>(*attrs.at("opus_bitrate").get<double>());
+    }
+
+    if (attrs.count("opus_complexity")) {
+        params.opus_complexity = static_cast<int>(*attrs.at("opus_complexity").get<double>());
+    }
+
+    if (attrs.count("buffer_duration_seconds")) {
+        params.buffer_duration_seconds = static_cast<int>(*attrs.at("buffer_duration_seconds").get<double>());
+    }
+
     VIAM_SDK_LOG(debug) << "[parseConfigAttributes] sucessfully parsed config attributes";
 
     return params;
 }
 
+// True when the attributes that determine how the PortAudio stream is opened
+// (device, rates, channels, latency, capture format, ring sizing) differ
+// between two parsed configs. Everything else - throttles, volume, silence
+// gating, encoder tuning, cache budgets - can be applied to a live stream in
+// place, so reconfigure only tears the stream down when this returns true.
+inline bool stream_affecting_config_changed(const ConfigParams& previous, const ConfigParams& updated) {
+    return previous.device_name != updated.device_name || previous.sample_rate != updated.sample_rate ||
+           previous.num_channels != updated.num_channels || previous.latency_ms != updated.latency_ms ||
+           previous.capture_format != updated.capture_format ||
+           previous.buffer_duration_seconds != updated.buffer_duration_seconds;
+}
+
 // Shared setup function that works for both microphone and speaker
 inline StreamParams setupStreamFromConfig(const ConfigParams& params,
                                           StreamDirection direction,
@@ -142,7 +226,9 @@ inline StreamParams setupStreamFromConfig(const ConfigParams& params,
         }
         VIAM_SDK_LOG(debug) << "[setupStreamFromConfig] Found default device named " << deviceInfo->name;
     } else {
-        device_index = findDeviceByName(device_name, audio_interface);
+        // Served from the cached enumeration snapshot in production; with an
+        // injected interface (tests) this scans it directly
+        device_index = audio::devices::DeviceRegistry::instance().find_by_name(device_name, pa);
         if (device_index == paNoDevice) {
             VIAM_SDK_LOG(error) << "[setupStreamFromConfig] Audio device with name '" << device_name << "' not found";
             throw std::runtime_error("audio device with name " + device_name + " not found");
@@ -172,7 +258,8 @@ inline StreamParams setupStreamFromConfig(const ConfigParams& params,
         test_params.sampleFormat = paInt16;
         test_params.suggestedLatency = deviceInfo->defaultLowInputLatency;
         test_params.hostApiSpecificStreamInfo = nullptr;
-        if (audio_interface.isFormatSupported(&test_params, nullptr, params.sample_rate.value()) == paNoError) {
+        if (audio::devices::DeviceRegistry::instance().is_format_supported(&test_params, nullptr, params.sample_rate.value(), pa) ==
+            paNoError) {
             VIAM_SDK_LOG(info) << "[setupStreamFromConfig] Requested sample rate " << params.sample_rate.value()
                                << " Hz is natively supported, using it directly";
             stream_params.sample_rate = params.sample_rate.value();
@@ -206,6 +293,45 @@ inline StreamParams setupStreamFromConfig(const ConfigParams& params,
         throw std::invalid_argument("num_channels exceeds device's maximum channels");
     }
 
+    // Negotiate the capture sample format for input streams. Hardcoding
+    // paInt16 forces PortAudio to down-convert 24/32-bit and float hardware
+    // internally; probing for the widest format the device accepts keeps that
+    // conversion in our callback where it is explicit, logged, and a plain
+    // shift/scale. Output streams stay paInt16 (the playback ring format).
+    stream_params.sample_format = paInt16;
+    if (direction == StreamDirection::Input) {
+        const std::string requested = params.capture_format.empty() ? "auto" : params.capture_format;
+        if (requested != "int16") {
+            PaStreamParameters probe;
+            probe.device = device_index;
+            probe.channelCount = stream_params.num_channels;
+            probe.suggestedLatency = stream_params.suggested_latency_seconds;
+            probe.hostApiSpecificStreamInfo = nullptr;
+
+            // Widest first - int32 and int24 cover high-resolution converters
+            // losslessly, float32 covers hosts that are natively float
+            const PaSampleFormat candidates[] = {paInt32, paInt24, paFloat32, paInt16};
+            for (const PaSampleFormat candidate : candidates) {
+                if (requested != "auto" && requested != sample_format_name(candidate)) {
+                    continue;
+                }
+                probe.sampleFormat = candidate;
+                if (audio::devices::DeviceRegistry::instance().is_format_supported(&probe, nullptr, stream_params.sample_rate, pa) ==
+                    paNoError) {
+                    stream_params.sample_format = candidate;
+                    break;
+                }
+            }
+            if (requested != "auto" && sample_format_name(stream_params.sample_format) != requested) {
+                VIAM_SDK_LOG(warn) << "[setupStreamFromConfig] Requested capture format '" << requested
+                                   << "' is not supported by the device, falling back to "
+                                   << sample_format_name(stream_params.sample_format);
+            }
+            VIAM_SDK_LOG(info) << "[setupStreamFromConfig] Negotiated capture format "
+                               << sample_format_name(stream_params.sample_format);
+        }
+    }
+
     stream_params.is_input = (direction == StreamDirection::Input);
     stream_params.callback = callback;
     stream_params.user_data = nullptr;  // Caller will set this after creating the audio context
@@ -223,7 +349,7 @@ inline void openStream(PaStream*& stream, const StreamParams& params, const audi
     PaStreamParameters stream_params;
     stream_params.device = params.device_index;
     stream_params.channelCount = params.num_channels;
-    stream_params.sampleFormat = paInt16;
+    stream_params.sampleFormat = params.sample_format;
     stream_params.suggestedLatency = params.suggested_latency_seconds;
     stream_params.hostApiSpecificStreamInfo = nullptr;
 
@@ -239,7 +365,7 @@ inline void openStream(PaStream*& stream, const StreamParams& params, const audi
                << "Requested configuration:\n"
                << "  - Sample rate: " << params.sample_rate << " Hz\n"
                << "  - Channels: " << params.num_channels << "\n"
-               << "  - Format: 16-bit PCM\n"
+               << "  - Format: " << sample_format_name(params.sample_format) << "\n"
                << "  - Latency: " << params.suggested_latency_seconds << " seconds";
         VIAM_SDK_LOG(error) << buffer.str();
         throw std::runtime_error(buffer.str());
@@ -388,7 +514,10 @@ inline AudioDeviceSetup<ContextType> setup_audio_device(const viam::sdk::Resourc
     setup.stream_params = setupStreamFromConfig(setup.config_params, direction, callback, pa);
 
     viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, setup.stream_params.sample_rate, setup.stream_params.num_channels};
-    setup.audio_context = std::make_shared<ContextType>(info, buffer_duration_seconds);
+    // The config attribute wins over the caller's default, so each component
+    // can trade memory for replayable history
+    setup.audio_context = std::make_shared<ContextType>(info, setup.config_params.buffer_duration_seconds.value_or(buffer_duration_seconds));
+    setup.audio_context->sample_format = setup.stream_params.sample_format;
 
     // Set user_data to point to the audio context
     setup.stream_params.user_data = setup.audio_context.get();
@@ -396,6 +525,20 @@ inline AudioDeviceSetup<ContextType> setup_audio_device(const viam::sdk::Resourc
     return setup;
 }
 
+// Renders the inter-callback interval histogram as a ProtoStruct keyed by
+// Prometheus-style bucket labels (le_<bound>ms, plus a final gt_ bucket), for
+// the stats do_command on both components
+inline viam::sdk::ProtoStruct callback_histogram_to_proto(const audio::CallbackIntervalHistogram& histogram) {
+    viam::sdk::ProtoStruct out;
+    for (std::size_t i = 0; i < audio::CallbackIntervalHistogram::BUCKET_UPPER_MS.size(); i++) {
+        out.emplace("le_" + std::to_string(audio::CallbackIntervalHistogram::BUCKET_UPPER_MS[i]) + "ms",
+                    static_cast<double>(histogram.bucket_count(i)));
+    }
+    out.emplace("gt_" + std::to_string(audio::CallbackIntervalHistogram::BUCKET_UPPER_MS.back()) + "ms",
+                static_cast<double>(histogram.bucket_count(audio::CallbackIntervalHistogram::NUM_BUCKETS - 1)));
+    return out;
+}
+
 constexpr uint64_t STREAM_RESTART_THRESHOLD_MS = 2000;
 constexpr uint64_t STALENESS_LOG_THROTTLE_NS = 1'000'000'000ULL;  // Log at most once per second
 
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <viam/sdk/common/utils.hpp>
+#include "portaudio.h"
+#include "portaudio.hpp"
+
+namespace audio {
+namespace devices {
+
+// How long a snapshot (and its cached format probes) stays valid before the
+// next access re-enumerates. PortAudio has no hotplug callbacks and its
+// device table is fixed at initialization, so staleness is bounded by this
+// TTL rather than a watcher thread - re-reading the table is microseconds,
+// and it keeps the probe cache from serving a device that was re-indexed by
+// an external PortAudio reinitialization.
+constexpr int DEVICE_REGISTRY_TTL_SECONDS = 30;
+
+// One enumerated device, with the capability fields discovery and stream
+// setup care about
+struct DeviceRecord {
+    PaDeviceIndex index = paNoDevice;
+    std::string name;
+    double default_sample_rate = 0;
+    int max_input_channels = 0;
+    int max_output_channels = 0;
+    double default_low_input_latency = 0;
+    double default_low_output_latency = 0;
+};
+
+// Process-wide cache of the PortAudio device table and of Pa_IsFormatSupported
+// probe results. Enumeration is a linear walk repeated by discovery, stream
+// setup, and every findDeviceByName, and format probes actually open the
+// device (~milliseconds each) - on hosts with many USB devices both add up to
+// multi-second discovery and serialized reconfigure storms. The registry
+// snapshots the table once, serves name→index and capability lookups from the
+// snapshot, and memoizes probe results until invalidate() or the TTL.
+//
+// All methods take the usual injected interface pointer: non-null (tests)
+// bypasses the cache entirely and calls straight through, so mock
+// expectations behave exactly as before; null (production) uses the cache
+// over RealPortAudio.
+class DeviceRegistry {
+   public:
+    static DeviceRegistry& instance() {
+        static DeviceRegistry registry;
+        return registry;
+    }
+
+    // Returns the enumeration snapshot, refreshing it if stale
+    std::vector<DeviceRecord> snapshot(const audio::portaudio::PortAudioInterface* pa = nullptr) {
+        if (pa) {
+            return enumerate(*pa);
+        }
+        std::lock_guard<std::mutex> lock(mu_);
+        ensure_fresh_locked();
+        return devices_;
+    }
+
+    // Name → device index from the snapshot. A miss forces one refresh and
+    // retries, so a device that appeared since the last snapshot still
+    // resolves. Returns paNoDevice if the name is unknown.
+    PaDeviceIndex find_by_name(const std::string& name, const audio::portaudio::PortAudioInterface* pa = nullptr) {
+        if (pa) {
+            return find_in(enumerate(*pa), name);
+        }
+        std::lock_guard<std::mutex> lock(mu_);
+        ensure_fresh_locked();
+        auto it = name_to_index_.find(name);
+        if (it == name_to_index_.end()) {
+            refresh_locked();
+            it = name_to_index_.find(name);
+        }
+        return it != name_to_index_.end() ? it->second : paNoDevice;
+    }
+
+    // Pa_IsFormatSupported with the result memoized per (device, direction,
+    // channels, format, rate). The probe opens the device, so repeated stream
+    // setups against the same configuration become map lookups.
+    PaError is_format_supported(const PaStreamParameters* input_params,
+                                const PaStreamParameters* output_params,
+                                double sample_rate,
+                                const audio::portaudio::PortAudioInterface* pa = nullptr) {
+        if (pa) {
+            return pa->isFormatSupported(input_params, output_params, sample_rate);
+        }
+
+        const std::string key = probe_key(input_params, output_params, sample_rate);
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            ensure_fresh_locked();
+            const auto it = probe_cache_.find(key);
+            if (it != probe_cache_.end()) {
+                return it->second;
+            }
+        }
+
+        // Probe outside the lock - it can take milliseconds, and concurrent
+        // setups for other devices shouldn't wait on it
+        const audio::portaudio::RealPortAudio real_pa;
+        const PaError result = real_pa.isFormatSupported(input_params, output_params, sample_rate);
+
+        std::lock_guard<std::mutex> lock(mu_);
+        probe_cache_[key] = result;
+        return result;
+    }
+
+    // Drops the snapshot and probe cache; the next access re-enumerates.
+    // Called when the device set is known to have changed.
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mu_);
+        valid_ = false;
+        devices_.clear();
+        name_to_index_.clear();
+        probe_cache_.clear();
+    }
+
+   private:
+    DeviceRegistry() = default;
+
+    static std::vector<DeviceRecord> enumerate(const audio::portaudio::PortAudioInterface& pa) {
+        std::vector<DeviceRecord> devices;
+        const int device_count = pa.getDeviceCount();
+        for (PaDeviceIndex i = 0; i < device_count; i++) {
+            const PaDeviceInfo* info = pa.getDeviceInfo(i);
+            if (!info || !info->name) {
+                VIAM_SDK_LOG(warn) << "[DeviceRegistry] could not get device info for device index " << i << ", skipping";
+                continue;
+            }
+            DeviceRecord record;
+            record.index = i;
+            record.name = info->name;
+            record.default_sample_rate = info->defaultSampleRate;
+            record.max_input_channels = info->maxInputChannels;
+            record.max_output_channels = info->maxOutputChannels;
+            record.default_low_input_latency = info->defaultLowInputLatency;
+            record.default_low_output_latency = info->defaultLowOutputLatency;
+            devices.push_back(std::move(record));
+        }
+        return devices;
+    }
+
+    static PaDeviceIndex find_in(const std::vector<DeviceRecord>& devices, const std::string& name) {
+        for (const auto& record : devices) {
+            if (record.name == name) {
+                return record.index;
+            }
+        }
+        return paNoDevice;
+    }
+
+    void ensure_fresh_locked() {
+        const auto now = std::chrono::steady_clock::now();
+        if (valid_ && now - snapshot_time_ < std::chrono::seconds(DEVICE_REGISTRY_TTL_SECONDS)) {
+            return;
+        }
+        refresh_locked();
+    }
+
+    void refresh_locked() {
+        const audio::portaudio::RealPortAudio real_pa;
+        devices_ = enumerate(real_pa);
+        name_to_index_.clear();
+        for (const auto& record : devices_) {
+            // Keep the first index for duplicate names, matching the old
+            // linear scan's behavior
+            name_to_index_.emplace(record.name, record.index);
+        }
+        probe_cache_.clear();
+        snapshot_time_ = std::chrono::steady_clock::now();
+        valid_ = true;
+        VIAM_SDK_LOG(debug) << "[DeviceRegistry] refreshed device snapshot: " << devices_.size() << " devices";
+    }
+
+    static std::string probe_key(const PaStreamParameters* input_params, const PaStreamParameters* output_params, double sample_rate) {
+        std::string key;
+        for (const PaStreamParameters* params : {input_params, output_params}) {
+            if (params) {
+                key += std::to_string(params->device) + ":" + std::to_string(params->channelCount) + ":" +
+                       std::to_string(params->sampleFormat) + ";";
+            } else {
+                key += "-;";
+            }
+        }
+        key += std::to_string(sample_rate);
+        return key;
+    }
+
+    std::mutex mu_;
+    bool valid_ = false;
+    std::chrono::steady_clock::time_point snapshot_time_{};
+    std::vector<DeviceRecord> devices_;
+    std::unordered_map<std::string, PaDeviceIndex> name_to_index_;
+    std::unordered_map<std::string, PaError> probe_cache_;
+};
+
+}  // namespace devices
+}  // namespace audio
@@ -4,6 +4,7 @@
 #include <viam/sdk/config/resource.hpp>
 #include <viam/sdk/resource/reconfigurable.hpp>
 #include <viam/sdk/services/discovery.hpp>
+#include "device_registry.hpp"
 #include "microphone.hpp"
 #include "portaudio.hpp"
 #include "speaker.hpp"
@@ -21,14 +22,16 @@ AudioDiscovery::AudioDiscovery(vsdk::Dependencies dependencies,
 std::vector<vsdk::ResourceConfig> AudioDiscovery::discover_resources(const vsdk::ProtoStruct& extra) {
     std::vector<vsdk::ResourceConfig> configs;
 
-    const int numDevices = pa_ ? pa_->getDeviceCount() : Pa_GetDeviceCount();
+    // Served from the process-wide enumeration snapshot - repeat discovery
+    // calls don't rewalk the PortAudio device table
+    const std::vector<audio::devices::DeviceRecord> devices = audio::devices::DeviceRegistry::instance().snapshot(pa_);
 
-    if (numDevices <= 0) {
+    if (devices.empty()) {
         VIAM_RESOURCE_LOG(warn) << "No audio devices found during discovery";
         return {};
     }
 
-    VIAM_RESOURCE_LOG(info) << "Discovery found " << numDevices << " audio devices";
+    VIAM_RESOURCE_LOG(info) << "Discovery found " << devices.size() << " audio devices";
 
     // Helper lambda to create device configs
     auto create_device_config = [this](const std::string& component_type,
@@ -84,29 +87,25 @@ std::vector<vsdk::ResourceConfig> AudioDiscovery::discover_resources(const vsdk:
     int count_input = 0;
     int count_output = 0;
 
-    for (int i = 0; i < numDevices; i++) {
-        const PaDeviceInfo* info = pa_ ? pa_->getDeviceInfo(i) : Pa_GetDeviceInfo(i);
-        const std::string device_name = info->name;
-        const double sample_rate = info->defaultSampleRate;
-
-        if (info->maxInputChannels > 0) {
+    for (const auto& device : devices) {
+        if (device.max_input_channels > 0) {
             add_device_config(microphone::Microphone::model,
                               "audio_in",
                               "microphone",
                               "rdk:component:audio_in",
-                              device_name,
-                              sample_rate,
-                              info->maxInputChannels,
+                              device.name,
+                              device.default_sample_rate,
+                              device.max_input_channels,
                               count_input);
         }
-        if (info->maxOutputChannels > 0) {
+        if (device.max_output_channels > 0) {
             add_device_config(speaker::Speaker::model,
                               "audio_out",
                               "speaker",
                               "rdk:component:audio_out",
-                              device_name,
-                              sample_rate,
-                              info->maxOutputChannels,
+                              device.name,
+                              device.default_sample_rate,
+                              device.max_output_channels,
                               count_output);
         }
     }
@@ -115,6 +114,28 @@ std::vector<vsdk::ResourceConfig> AudioDiscovery::discover_resources(const vsdk:
 }
 
 vsdk::ProtoStruct AudioDiscovery::do_command(const vsdk::ProtoStruct& command) {
+    if (command.count("refresh_devices")) {
+        // Drop the cached enumeration snapshot and probe results so the next
+        // discovery or stream setup re-enumerates (e.g. after plugging in a
+        // device and reinitializing PortAudio)
+        audio::devices::DeviceRegistry::instance().invalidate();
+        const auto devices = audio::devices::DeviceRegistry::instance().snapshot(pa_);
+        return vsdk::ProtoStruct{{"refreshed", true}, {"devices", static_cast<double>(devices.size())}};
+    }
+
+    if (command.count("stats")) {
+        const auto devices = audio::devices::DeviceRegistry::instance().snapshot(pa_);
+        int inputs = 0;
+        int outputs = 0;
+        for (const auto& device : devices) {
+            if (device.max_input_channels > 0) inputs++;
+            if (device.max_output_channels > 0) outputs++;
+        }
+        return vsdk::ProtoStruct{{"devices", static_cast<double>(devices.size())},
+                                 {"input_devices", static_cast<double>(inputs)},
+                                 {"output_devices", static_cast<double>(outputs)}};
+    }
+
     VIAM_RESOURCE_LOG(error) << "do_command not implemented";
     return vsdk::ProtoStruct{};
 }
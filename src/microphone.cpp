@@ -1,6 +1,8 @@
 #include "microphone.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <exception>
 #include <sstream>
 #include <thread>
 #include "audio_buffer.hpp"
@@ -50,17 +52,24 @@ int calculate_aligned_chunk_size(int sample_rate, int num_channels, int mp3_fram
 }
 
 // Calculate chunk size based on codec and audio format
-// For MP3, aligns chunk size with the mp3 frame size
+// For MP3 and Opus, aligns chunk size with the encoder's frame size
 static int calculate_chunk_size(const audio::codec::AudioCodec codec,
                                 int sample_rate,
                                 int num_channels,
-                                const MP3EncoderContext* mp3_ctx = nullptr) {
+                                const MP3EncoderContext* mp3_ctx = nullptr,
+                                const OpusEncoderContext* opus_ctx = nullptr) {
     if (codec == AudioCodec::MP3) {
         if (mp3_ctx == nullptr || mp3_ctx->frame_size == 0) {
             throw std::invalid_argument("MP3 encoder must be initialized before calculating chunk size");
         }
         // Use actual frame size from LAME
         return calculate_aligned_chunk_size(sample_rate, num_channels, mp3_ctx->frame_size);
+    } else if (codec == AudioCodec::OPUS) {
+        if (opus_ctx == nullptr || opus_ctx->frame_size == 0) {
+            throw std::invalid_argument("Opus encoder must be initialized before calculating chunk size");
+        }
+        // Whole 20ms Opus frames - opus_encode only accepts exact frame sizes
+        return calculate_aligned_chunk_size(sample_rate, num_channels, opus_ctx->frame_size);
     } else {
         // PCM codecs: 100ms chunks
         const int num_samples_per_100_ms = static_cast<int>(sample_rate * 0.1);
@@ -68,29 +77,262 @@ static int calculate_chunk_size(const audio::codec::AudioCodec codec,
     }
 }
 
+int calculate_catchup_read_size(uint64_t available_samples,
+                                int device_samples_per_chunk,
+                                int stream_sample_rate,
+                                int requested_sample_rate,
+                                int bytes_per_output_sample,
+                                int max_chunk_bytes) {
+    // Translate the output-byte cap into a device-sample cap, accounting for
+    // the rate change when the session resamples
+    const uint64_t max_output_samples = static_cast<uint64_t>(max_chunk_bytes) / bytes_per_output_sample;
+    uint64_t max_device_samples = max_output_samples;
+    if (stream_sample_rate != requested_sample_rate) {
+        max_device_samples = static_cast<uint64_t>(max_output_samples * static_cast<double>(stream_sample_rate) / requested_sample_rate);
+    }
+
+    uint64_t target = std::min(available_samples, max_device_samples);
+
+    // Round down to whole chunks so MP3 deliveries stay frame aligned, but
+    // always read at least one chunk
+    target = (target / device_samples_per_chunk) * device_samples_per_chunk;
+    if (target < static_cast<uint64_t>(device_samples_per_chunk)) {
+        target = device_samples_per_chunk;
+    }
+    return static_cast<int>(target);
+}
+
 // RAII guard to automatically increment and decrement the stream counter
 // during get_audio calls
 class StreamGuard {
-    std::mutex& mutex_;
-    int& counter_;
+    std::atomic<int>& counter_;
+
+   public:
+    explicit StreamGuard(std::atomic<int>& c) : counter_(c) { counter_.fetch_add(1, std::memory_order_relaxed); }
+    ~StreamGuard() { counter_.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+// One pre-read PCM chunk handed from the reader stage to the encoder stage
+// of a pipelined mp3 session
+struct PipelinedChunk {
+    std::vector<int16_t> samples;
+    int sample_count = 0;
+    uint64_t start_position = 0;
+};
 
+// Small bounded queue between the reader and encoder stages. Consumed sample
+// buffers are recycled through a free list so the steady-state pipeline does
+// not allocate.
+class BoundedChunkQueue {
    public:
-    StreamGuard(std::mutex& m, int& c) : mutex_(m), counter_(c) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        counter_++;
+    explicit BoundedChunkQueue(size_t capacity) : capacity_(capacity) {}
+
+    // Blocks while the queue is full. Returns false once the queue is closed.
+    bool push(PipelinedChunk&& chunk) {
+        std::unique_lock<std::mutex> lock(mu_);
+        not_full_cv_.wait(lock, [&] { return queue_.size() < capacity_ || closed_; });
+        if (closed_) {
+            return false;
+        }
+        queue_.push_back(std::move(chunk));
+        not_empty_cv_.notify_one();
+        return true;
+    }
+
+    // Blocks while the queue is empty. Returns false once the queue is
+    // closed and drained.
+    bool pop(PipelinedChunk& chunk) {
+        std::unique_lock<std::mutex> lock(mu_);
+        not_empty_cv_.wait(lock, [&] { return !queue_.empty() || closed_; });
+        if (queue_.empty()) {
+            return false;
+        }
+        chunk = std::move(queue_.front());
+        queue_.pop_front();
+        not_full_cv_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mu_);
+        closed_ = true;
+        not_full_cv_.notify_all();
+        not_empty_cv_.notify_all();
     }
-    ~StreamGuard() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        counter_--;
+
+    // Returns a consumed sample buffer to the reader's free list
+    void recycle(std::vector<int16_t>&& buffer) {
+        std::lock_guard<std::mutex> lock(mu_);
+        free_buffers_.push_back(std::move(buffer));
+    }
+
+    // Obtains a recycled buffer, or an empty one if none is free yet
+    std::vector<int16_t> take_buffer() {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (free_buffers_.empty()) {
+            return {};
+        }
+        std::vector<int16_t> buffer = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+        return buffer;
     }
+
+   private:
+    const size_t capacity_;
+    std::mutex mu_;
+    std::condition_variable not_full_cv_;
+    std::condition_variable not_empty_cv_;
+    std::deque<PipelinedChunk> queue_;
+    std::vector<std::vector<int16_t>> free_buffers_;
+    bool closed_ = false;
 };
 
+// === SharedMP3Encoder Implementation ===
+
+SharedMP3Encoder::SharedMP3Encoder(std::shared_ptr<audio::InputStreamContext> stream_context,
+                                   int device_sample_rate,
+                                   int sample_rate,
+                                   int num_channels,
+                                   MicrophoneStats* stats)
+    : stream_context_(std::move(stream_context)), sample_rate_(sample_rate), num_channels_(num_channels), stats_(stats) {
+    initialize_mp3_encoder(ctx_, sample_rate_, num_channels_);
+
+    const int samples_per_chunk = calculate_aligned_chunk_size(sample_rate_, num_channels_, ctx_.frame_size);
+    device_samples_per_chunk_ = samples_per_chunk;
+    if (device_sample_rate != sample_rate_) {
+        device_samples_per_chunk_ = std::lround(samples_per_chunk * device_sample_rate / sample_rate_);
+        resampler_ = std::make_unique<audio::Resampler>(device_sample_rate, sample_rate_, num_channels_);
+    }
+    pcm_buffer_.resize(device_samples_per_chunk_);
+
+    // Start encoding from live audio. History before this point is served by
+    // per-session encoders (previous_timestamp resume).
+    encode_read_position_ = stream_context_->get_write_position();
+}
+
+uint64_t SharedMP3Encoder::next_sequence() {
+    std::lock_guard<std::mutex> lock(ring_mu_);
+    return next_sequence_;
+}
+
+bool SharedMP3Encoder::get_chunk(uint64_t& sequence, EncodedMP3Chunk& out, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(ring_mu_);
+            if (!ring_.empty() && sequence < ring_.front().sequence) {
+                VIAM_SDK_LOG(warn) << "[get_audio] mp3 session fell behind the shared encoded ring - skipping ahead "
+                                   << (ring_.front().sequence - sequence) << " chunk(s)";
+                sequence = ring_.front().sequence;
+            }
+            if (!ring_.empty() && sequence <= ring_.back().sequence) {
+                out = ring_[sequence - ring_.front().sequence];
+                return true;
+            }
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+
+        // The chunk has not been produced yet: become the producer, or wait
+        // for whichever session currently is
+        std::unique_lock<std::mutex> encode_lock(encode_mu_, std::try_to_lock);
+        if (encode_lock.owns_lock()) {
+            if (!produce_next_chunk(deadline)) {
+                return false;
+            }
+            chunk_cv_.notify_all();
+        } else {
+            std::unique_lock<std::mutex> lock(ring_mu_);
+            const bool ready =
+                chunk_cv_.wait_until(lock, deadline, [&] { return !ring_.empty() && sequence <= ring_.back().sequence; });
+            if (!ready) {
+                return false;
+            }
+        }
+    }
+}
+
+bool SharedMP3Encoder::produce_next_chunk(std::chrono::steady_clock::time_point deadline) {
+    // Wait until the capture ring holds a full chunk at the encode cursor
+    int samples_read = 0;
+    uint64_t chunk_start_position = 0;
+    while (true) {
+        const uint64_t needed = encode_read_position_ + device_samples_per_chunk_;
+        if (stream_context_->get_write_position() < needed) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            stream_context_->wait_for_write_position(needed, std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now));
+            continue;
+        }
+
+        chunk_start_position = encode_read_position_;
+        samples_read = stream_context_->read_samples(pcm_buffer_.data(), device_samples_per_chunk_, encode_read_position_);
+        if (samples_read == device_samples_per_chunk_) {
+            break;
+        }
+        // The capture ring overwrote the cursor mid-read; read_samples already
+        // skipped it forward, so retry from the new position
+    }
+
+    int16_t* final_samples = pcm_buffer_.data();
+    int final_sample_count = samples_read;
+    if (resampler_) {
+        const auto resample_start = std::chrono::steady_clock::now();
+        resampler_->process(pcm_buffer_.data(), samples_read, resampled_buffer_);
+        if (stats_) {
+            stats_->resample_ns_total.fetch_add((std::chrono::steady_clock::now() - resample_start).count(), std::memory_order_relaxed);
+            stats_->resample_chunks.fetch_add(1, std::memory_order_relaxed);
+        }
+        final_samples = resampled_buffer_.data();
+        final_sample_count = static_cast<int>(resampled_buffer_.size());
+    }
+
+    EncodedMP3Chunk chunk;
+    // Record the source level so each session can apply its own silence gate
+    chunk.rms = audio::codec::compute_rms(pcm_buffer_.data(), samples_read);
+    const auto encode_start = std::chrono::steady_clock::now();
+    encode_samples_to_mp3(ctx_, final_samples, final_sample_count, chunk_start_position, chunk.data);
+    if (stats_) {
+        stats_->encode_ns_total.fetch_add((std::chrono::steady_clock::now() - encode_start).count(), std::memory_order_relaxed);
+        stats_->encode_chunks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Timestamps should reflect the data the encoder returned - adjust for
+    // the LAME encoder delay, as the per-session encode path does
+    uint64_t start_position = chunk_start_position;
+    uint64_t end_position = chunk_start_position + samples_read;
+    const int delay_samples = ctx_.encoder_delay * num_channels_;
+    if (start_position >= delay_samples) {
+        start_position -= delay_samples;
+    } else {
+        start_position = 0;
+    }
+    end_position -= delay_samples;
+
+    chunk.start_position = start_position;
+    chunk.end_position = end_position;
+
+    {
+        std::lock_guard<std::mutex> lock(ring_mu_);
+        chunk.sequence = next_sequence_++;
+        ring_.push_back(std::move(chunk));
+        if (ring_.size() > MAX_RING_CHUNKS) {
+            ring_.pop_front();
+        }
+    }
+    return true;
+}
+
 // === Microphone Class Implementation ===
 
 void Microphone::restart_stalled_stream(const std::shared_ptr<audio::InputStreamContext>& stream_context) {
     std::lock_guard<std::mutex> lock(stream_ctx_mu_);
     // Only restart if this is still the active context — another thread may have already restarted.
-    if (stream_context != audio_context_) {
+    if (stream_context != std::atomic_load(&audio_context_)) {
         return;
     }
 
@@ -105,17 +347,32 @@ void Microphone::restart_stalled_stream(const std::shared_ptr<audio::InputStream
         stream_ = nullptr;
     }
 
-    const viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, stream_params_.sample_rate, stream_params_.num_channels};
-    const auto new_context = std::make_shared<audio::InputStreamContext>(info, audio::BUFFER_DURATION_SECONDS);
+    // Take the pre-warmed standby context instead of allocating - swapping in
+    // a multi-second ring becomes a pointer move, and the allocation for the
+    // next restart happens below, after the stream is already running again
+    std::shared_ptr<audio::InputStreamContext> new_context = std::move(standby_context_);
+    if (!new_context) {
+        const viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, stream_params_.sample_rate, stream_params_.num_channels};
+        new_context = std::make_shared<audio::InputStreamContext>(info, buffer_duration_seconds_);
+    }
+    new_context->sample_format = stream_params_.sample_format;
 
     try {
         stream_params_.user_data = new_context.get();
         audio::utils::restart_stream(stream_, stream_params_, pa_);
         latency_ = audio::utils::get_stream_latency(stream_, stream_params_, pa_);
-        audio_context_ = new_context;
+        std::atomic_store(&audio_context_, new_context);
+        // Keep the stalled context's frozen ring so timestamp-based reads
+        // spanning the restart can still replay it
+        retired_context_ = stream_context;
+        retired_at_ = std::chrono::steady_clock::now();
         restart_attempts_ = 0;
+        stats_.restarts.fetch_add(1, std::memory_order_relaxed);
         VIAM_SDK_LOG(info) << "[get_audio] Stream restarted successfully";
+        prewarm_standby_context_locked();
     } catch (const std::exception& e) {
+        // Put the spare back so the next attempt stays allocation-free
+        standby_context_ = std::move(new_context);
         ++restart_attempts_;
         if (restart_attempts_ >= MAX_STREAM_RESTART_ATTEMPTS) {
             VIAM_SDK_LOG(error) << "[get_audio] Failed to restart stream after " << MAX_STREAM_RESTART_ATTEMPTS
@@ -127,15 +384,86 @@ void Microphone::restart_stalled_stream(const std::shared_ptr<audio::InputStream
     }
 }
 
+void Microphone::prewarm_standby_context_locked() {
+    const viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, stream_params_.sample_rate, stream_params_.num_channels};
+    standby_context_ = std::make_shared<audio::InputStreamContext>(info, buffer_duration_seconds_);
+    standby_context_->sample_format = stream_params_.sample_format;
+}
+
+std::shared_ptr<audio::InputStreamContext> Microphone::retired_context_covering(int64_t previous_timestamp) {
+    if (previous_timestamp <= 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+    if (!retired_context_) {
+        return nullptr;
+    }
+    // Drop the frozen ring once it has been retained for the full history
+    // window - everything in it is older than the live ring now covers
+    if (std::chrono::steady_clock::now() - retired_at_ > std::chrono::seconds(buffer_duration_seconds_)) {
+        retired_context_.reset();
+        return nullptr;
+    }
+    const auto active = std::atomic_load(&audio_context_);
+    if (!active) {
+        return nullptr;
+    }
+    // Only route to the retired context for timestamps the live context
+    // cannot serve. Until the live context's first callback lands its start
+    // time is unset, so everything historical belongs to the retired ring.
+    int64_t active_start_ns;
+    if (active->first_callback_captured.load()) {
+        active_start_ns =
+            std::chrono::time_point_cast<std::chrono::nanoseconds>(active->stream_start_time).time_since_epoch().count();
+    } else {
+        active_start_ns =
+            std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
+    }
+    if (previous_timestamp >= active_start_ns) {
+        return nullptr;
+    }
+    return retired_context_;
+}
+
+void Microphone::check_stream_health(const std::shared_ptr<audio::InputStreamContext>& stream_context,
+                                     PaStream* current_stream,
+                                     uint64_t& last_staleness_log_ns,
+                                     uint64_t& last_logged_overflow_count,
+                                     uint64_t& last_logged_underflow_count) {
+    // Staleness is logged here for session visibility, but recovery belongs
+    // to the module supervisor thread - readers observe the context swap on
+    // their next iteration rather than racing each other to restart
+    audio::utils::log_callback_staleness(stream_context->last_callback_time_ns, "[get_audio]", current_stream, last_staleness_log_ns);
+
+    const uint64_t overflow_count = stream_context->input_overflow_count.load();
+    if (overflow_count != last_logged_overflow_count) {
+        VIAM_SDK_LOG(warn) << "[get_audio] Input overflow detected — " << (overflow_count - last_logged_overflow_count)
+                           << " new overflow(s), " << overflow_count << " total";
+        last_logged_overflow_count = overflow_count;
+    }
+
+    const uint64_t underflow_count = stream_context->input_underflow_count.load();
+    if (underflow_count != last_logged_underflow_count) {
+        VIAM_SDK_LOG(warn) << "[get_audio] Input underflow detected — " << (underflow_count - last_logged_underflow_count)
+                           << " new underflow(s), " << underflow_count << " total";
+        last_logged_underflow_count = underflow_count;
+    }
+}
+
 void Microphone::setup_stream_params(AudioCodec codec_enum,
                                      MP3EncoderContext& mp3_ctx,
+                                     OpusEncoderContext& opus_ctx,
                                      bool is_reconfigure,
                                      int& stream_sample_rate,
                                      int& requested_sample_rate,
                                      int& stream_num_channels,
                                      int& stream_historical_throttle_ms,
+                                     int& stream_catchup_max_chunk_bytes,
                                      int& samples_per_chunk,
                                      int& device_samples_per_chunk) {
+    int opus_bitrate = OPUS_DEFAULT_BITRATE;
+    int opus_complexity = OPUS_DEFAULT_COMPLEXITY;
+
     // Get current stream parameters
     {
         std::lock_guard<std::mutex> lock(stream_ctx_mu_);
@@ -143,18 +471,26 @@ void Microphone::setup_stream_params(AudioCodec codec_enum,
         requested_sample_rate = requested_sample_rate_;
         stream_num_channels = stream_params_.num_channels;
         stream_historical_throttle_ms = historical_throttle_ms_;
+        stream_catchup_max_chunk_bytes = catchup_max_chunk_bytes_;
+        opus_bitrate = opus_bitrate_;
+        opus_complexity = opus_complexity_;
     }
 
-    // Initialize or reinitialize MP3 encoder if needed
+    // Initialize or reinitialize the encoder if needed
     if (codec_enum == AudioCodec::MP3) {
         if (is_reconfigure) {
             cleanup_mp3_encoder(mp3_ctx);
         }
         initialize_mp3_encoder(mp3_ctx, requested_sample_rate, stream_num_channels);
+    } else if (codec_enum == AudioCodec::OPUS) {
+        if (is_reconfigure) {
+            cleanup_opus_encoder(opus_ctx);
+        }
+        initialize_opus_encoder(opus_ctx, requested_sample_rate, stream_num_channels, opus_bitrate, opus_complexity);
     }
 
     // Calculate chunk size based on codec
-    samples_per_chunk = calculate_chunk_size(codec_enum, requested_sample_rate, stream_num_channels, &mp3_ctx);
+    samples_per_chunk = calculate_chunk_size(codec_enum, requested_sample_rate, stream_num_channels, &mp3_ctx, &opus_ctx);
 
     // Calculate how many samples to read from device buffer
     device_samples_per_chunk = samples_per_chunk;
@@ -195,15 +531,44 @@ Microphone::Microphone(viam::sdk::Dependencies deps, viam::sdk::ResourceConfig c
         stream_params_.user_data = setup.audio_context.get();
         audio::utils::restart_stream(stream_, stream_params_, pa_);
         latency_ = audio::utils::get_stream_latency(stream_, stream_params_, pa_);
-        audio_context_ = setup.audio_context;
+        std::atomic_store(&audio_context_, setup.audio_context);
         requested_sample_rate_ =
             setup.config_params.sample_rate.value_or(setup.stream_params.sample_rate);  // User's requested rate, defaults to device rate
         historical_throttle_ms_ = setup.config_params.historical_throttle_ms.value_or(DEFAULT_HISTORICAL_THROTTLE_MS);
+        catchup_max_chunk_bytes_ = setup.config_params.catchup_max_chunk_bytes.value_or(DEFAULT_CATCHUP_MAX_CHUNK_BYTES);
+        silence_suppression_ = setup.config_params.silence_suppression.value_or(false);
+        silence_threshold_rms_ = setup.config_params.silence_threshold_rms.value_or(DEFAULT_SILENCE_THRESHOLD_RMS);
+        silence_hang_ms_ = setup.config_params.silence_hang_ms.value_or(DEFAULT_SILENCE_HANG_MS);
+        opus_bitrate_ = setup.config_params.opus_bitrate.value_or(OPUS_DEFAULT_BITRATE);
+        opus_complexity_ = setup.config_params.opus_complexity.value_or(OPUS_DEFAULT_COMPLEXITY);
+        buffer_duration_seconds_ = setup.config_params.buffer_duration_seconds.value_or(audio::BUFFER_DURATION_SECONDS);
+        config_params_ = setup.config_params;
+        prewarm_standby_context_locked();
     }
+
+    // Hand stall recovery to the module supervisor so a stalled capture
+    // stream restarts even with no connected clients
+    supervisor_watch_ = audio::supervision::StreamSupervisor::instance().register_stream(
+        cfg.name(),
+        [this]() -> uint64_t {
+            auto ctx = std::atomic_load(&audio_context_);
+            return ctx ? ctx->last_callback_time_ns.load() : 0;
+        },
+        [this]() {
+            auto ctx = std::atomic_load(&audio_context_);
+            if (ctx) {
+                restart_stalled_stream(ctx);
+            }
+        });
 }
 
 Microphone::~Microphone() {
     VIAM_SDK_LOG(debug) << "[Microphone::~Microphone] Destructor called";
+    // Unregister first: this blocks until any in-flight supervisor restart
+    // has returned, so the closures cannot touch a dead Microphone
+    if (supervisor_watch_ != 0) {
+        audio::supervision::StreamSupervisor::instance().unregister_stream(supervisor_watch_);
+    }
     if (stream_) {
         PaError err = Pa_StopStream(stream_);
         if (err != paNoError) {
@@ -275,6 +640,99 @@ std::vector<std::string> Microphone::validate(viam::sdk::ResourceConfig cfg) {
             throw std::invalid_argument("historical_throttle_ms must be non-negative");
         }
     }
+
+    if (attrs.count("catchup_max_chunk_bytes")) {
+        if (!attrs["catchup_max_chunk_bytes"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] catchup_max_chunk_bytes attribute must be a number";
+            throw std::invalid_argument("catchup_max_chunk_bytes attribute must be a number");
+        }
+        const double catchup_max_chunk_bytes = *attrs.at("catchup_max_chunk_bytes").get<double>();
+        if (catchup_max_chunk_bytes < 0) {
+            VIAM_SDK_LOG(error) << "[validate] catchup_max_chunk_bytes must be non-negative";
+            throw std::invalid_argument("catchup_max_chunk_bytes must be non-negative");
+        }
+    }
+
+    if (attrs.count("silence_suppression")) {
+        if (!attrs["silence_suppression"].is_a<bool>()) {
+            VIAM_SDK_LOG(error) << "[validate] silence_suppression attribute must be a boolean";
+            throw std::invalid_argument("silence_suppression attribute must be a boolean");
+        }
+    }
+
+    if (attrs.count("silence_threshold_rms")) {
+        if (!attrs["silence_threshold_rms"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] silence_threshold_rms attribute must be a number";
+            throw std::invalid_argument("silence_threshold_rms attribute must be a number");
+        }
+        const double silence_threshold_rms = *attrs.at("silence_threshold_rms").get<double>();
+        if (silence_threshold_rms < 0 || silence_threshold_rms > 1) {
+            VIAM_SDK_LOG(error) << "[validate] silence_threshold_rms must be between 0 and 1";
+            throw std::invalid_argument("silence_threshold_rms must be between 0 and 1");
+        }
+    }
+
+    if (attrs.count("silence_hang_ms")) {
+        if (!attrs["silence_hang_ms"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] silence_hang_ms attribute must be a number";
+            throw std::invalid_argument("silence_hang_ms attribute must be a number");
+        }
+        const double silence_hang_ms = *attrs.at("silence_hang_ms").get<double>();
+        if (silence_hang_ms < 0) {
+            VIAM_SDK_LOG(error) << "[validate] silence_hang_ms must be non-negative";
+            throw std::invalid_argument("silence_hang_ms must be non-negative");
+        }
+    }
+
+    if (attrs.count("opus_bitrate")) {
+        if (!attrs["opus_bitrate"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] opus_bitrate attribute must be a number";
+            throw std::invalid_argument("opus_bitrate attribute must be a number");
+        }
+        const double opus_bitrate = *attrs.at("opus_bitrate").get<double>();
+        // Bitrate bounds from the Opus specification
+        if (opus_bitrate < 6000 || opus_bitrate > 510000) {
+            VIAM_SDK_LOG(error) << "[validate] opus_bitrate must be between 6000 and 510000";
+            throw std::invalid_argument("opus_bitrate must be between 6000 and 510000");
+        }
+    }
+
+    if (attrs.count("opus_complexity")) {
+        if (!attrs["opus_complexity"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] opus_complexity attribute must be a number";
+            throw std::invalid_argument("opus_complexity attribute must be a number");
+        }
+        const double opus_complexity = *attrs.at("opus_complexity").get<double>();
+        if (opus_complexity < 0 || opus_complexity > 10) {
+            VIAM_SDK_LOG(error) << "[validate] opus_complexity must be between 0 and 10";
+            throw std::invalid_argument("opus_complexity must be between 0 and 10");
+        }
+    }
+
+    if (attrs.count("capture_format")) {
+        if (!attrs["capture_format"].is_a<std::string>()) {
+            VIAM_SDK_LOG(error) << "[validate] capture_format attribute must be a string";
+            throw std::invalid_argument("capture_format attribute must be a string");
+        }
+        const std::string capture_format = *attrs.at("capture_format").get<std::string>();
+        if (capture_format != "auto" && capture_format != "int16" && capture_format != "int24" && capture_format != "int32" &&
+            capture_format != "float32") {
+            VIAM_SDK_LOG(error) << "[validate] capture_format must be one of: auto, int16, int24, int32, float32";
+            throw std::invalid_argument("capture_format must be one of: auto, int16, int24, int32, float32");
+        }
+    }
+
+    if (attrs.count("buffer_duration_seconds")) {
+        if (!attrs["buffer_duration_seconds"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] buffer_duration_seconds attribute must be a number";
+            throw std::invalid_argument("buffer_duration_seconds attribute must be a number");
+        }
+        const double buffer_duration_seconds = *attrs.at("buffer_duration_seconds").get<double>();
+        if (buffer_duration_seconds <= 0) {
+            VIAM_SDK_LOG(error) << "[validate] buffer_duration_seconds must be greater than zero";
+            throw std::invalid_argument("buffer_duration_seconds must be greater than zero");
+        }
+    }
     return {};
 }
 
@@ -282,17 +740,36 @@ void Microphone::reconfigure(const viam::sdk::Dependencies& deps, const viam::sd
     VIAM_SDK_LOG(info) << "[reconfigure] Microphone reconfigure start";
 
     try {
+        // Fast path: when the pushed config leaves every stream-affecting
+        // attribute untouched (fleet-wide pushes usually do), apply the
+        // remaining attributes in place and keep the live stream, its ring
+        // history, and all connected sessions intact.
+        const auto new_params = audio::utils::parseConfigAttributes(cfg);
+        {
+            std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+            if (stream_ != nullptr && !audio::utils::stream_affecting_config_changed(config_params_, new_params)) {
+                historical_throttle_ms_ = new_params.historical_throttle_ms.value_or(DEFAULT_HISTORICAL_THROTTLE_MS);
+                catchup_max_chunk_bytes_ = new_params.catchup_max_chunk_bytes.value_or(DEFAULT_CATCHUP_MAX_CHUNK_BYTES);
+                silence_suppression_ = new_params.silence_suppression.value_or(false);
+                silence_threshold_rms_ = new_params.silence_threshold_rms.value_or(DEFAULT_SILENCE_THRESHOLD_RMS);
+                silence_hang_ms_ = new_params.silence_hang_ms.value_or(DEFAULT_SILENCE_HANG_MS);
+                opus_bitrate_ = new_params.opus_bitrate.value_or(OPUS_DEFAULT_BITRATE);
+                opus_complexity_ = new_params.opus_complexity.value_or(OPUS_DEFAULT_COMPLEXITY);
+                config_params_ = new_params;
+                VIAM_SDK_LOG(info) << "[reconfigure] Stream parameters unchanged, applied config without stream restart";
+                return;
+            }
+        }
+
         // Warn if reconfiguring with active streams
         // Changing the sample rate or number of channels mid stream
         // might cause issues client side, clients need to be actively
         // checking the audioinfo for changes. Changing these parameters
         // may also cause a small gap in audio.
-        {
-            std::lock_guard<std::mutex> lock(stream_ctx_mu_);
-            if (active_streams_ > 0) {
-                VIAM_SDK_LOG(info) << "[reconfigure] Reconfiguring with " << active_streams_
-                                   << " active stream(s). See README for reconfiguration considerations.";
-            }
+        const int active_streams = active_streams_.load();
+        if (active_streams > 0) {
+            VIAM_SDK_LOG(info) << "[reconfigure] Reconfiguring with " << active_streams
+                               << " active stream(s). See README for reconfiguration considerations.";
         }
 
         // Close the existing stream before setting up audio device — Pa_IsFormatSupported internally tries to
@@ -316,10 +793,24 @@ void Microphone::reconfigure(const viam::sdk::Dependencies& deps, const viam::sd
             stream_params_.user_data = setup.audio_context.get();
             audio::utils::restart_stream(stream_, stream_params_, pa_);
             latency_ = audio::utils::get_stream_latency(stream_, stream_params_, pa_);
-            audio_context_ = setup.audio_context;
+            std::atomic_store(&audio_context_, setup.audio_context);
             requested_sample_rate_ = setup.config_params.sample_rate.value_or(
                 setup.stream_params.sample_rate);  // User's requested rate, defaults to device rate
             historical_throttle_ms_ = setup.config_params.historical_throttle_ms.value_or(DEFAULT_HISTORICAL_THROTTLE_MS);
+            catchup_max_chunk_bytes_ = setup.config_params.catchup_max_chunk_bytes.value_or(DEFAULT_CATCHUP_MAX_CHUNK_BYTES);
+            silence_suppression_ = setup.config_params.silence_suppression.value_or(false);
+            silence_threshold_rms_ = setup.config_params.silence_threshold_rms.value_or(DEFAULT_SILENCE_THRESHOLD_RMS);
+            silence_hang_ms_ = setup.config_params.silence_hang_ms.value_or(DEFAULT_SILENCE_HANG_MS);
+            opus_bitrate_ = setup.config_params.opus_bitrate.value_or(OPUS_DEFAULT_BITRATE);
+            opus_complexity_ = setup.config_params.opus_complexity.value_or(OPUS_DEFAULT_COMPLEXITY);
+            buffer_duration_seconds_ = setup.config_params.buffer_duration_seconds.value_or(audio::BUFFER_DURATION_SECONDS);
+            config_params_ = setup.config_params;
+            // Drop the shared mp3 encode stage - live sessions rebuild it
+            // against the new capture context on their next chunk
+            shared_mp3_encoder_.reset();
+            // The retained pre-restart ring may not match the new format
+            retired_context_.reset();
+            prewarm_standby_context_locked();
         }
         VIAM_SDK_LOG(info) << "[reconfigure] Reconfigure completed successfully";
     } catch (const std::exception& e) {
@@ -329,103 +820,161 @@ void Microphone::reconfigure(const viam::sdk::Dependencies& deps, const viam::sd
 }
 
 viam::sdk::ProtoStruct Microphone::do_command(const viam::sdk::ProtoStruct& command) {
+    if (command.count("stats")) {
+        viam::sdk::ProtoStruct stats;
+        stats.emplace("active_streams", static_cast<double>(active_streams_.load(std::memory_order_relaxed)));
+        stats.emplace("restarts", static_cast<double>(stats_.restarts.load(std::memory_order_relaxed)));
+        stats.emplace("encode_ns_total", static_cast<double>(stats_.encode_ns_total.load(std::memory_order_relaxed)));
+        stats.emplace("encode_chunks", static_cast<double>(stats_.encode_chunks.load(std::memory_order_relaxed)));
+        stats.emplace("resample_ns_total", static_cast<double>(stats_.resample_ns_total.load(std::memory_order_relaxed)));
+        stats.emplace("resample_chunks", static_cast<double>(stats_.resample_chunks.load(std::memory_order_relaxed)));
+        stats.emplace("delivery_ns_total", static_cast<double>(stats_.delivery_ns_total.load(std::memory_order_relaxed)));
+        stats.emplace("delivered_chunks", static_cast<double>(stats_.delivered_chunks.load(std::memory_order_relaxed)));
+
+        auto ctx = std::atomic_load(&audio_context_);
+        if (ctx) {
+            const uint64_t write_position = ctx->get_write_position();
+            stats.emplace("samples_written", static_cast<double>(write_position));
+            stats.emplace("input_overflows", static_cast<double>(ctx->input_overflow_count.load(std::memory_order_relaxed)));
+            stats.emplace("input_underflows", static_cast<double>(ctx->input_underflow_count.load(std::memory_order_relaxed)));
+            stats.emplace("ring_capacity", static_cast<double>(ctx->buffer_capacity));
+            const uint64_t filled = std::min<uint64_t>(write_position, ctx->buffer_capacity);
+            stats.emplace("ring_fill", ctx->buffer_capacity > 0 ? static_cast<double>(filled) / ctx->buffer_capacity : 0.0);
+            stats.emplace("callback_intervals", audio::utils::callback_histogram_to_proto(ctx->callback_interval_histogram));
+        }
+        return stats;
+    }
+
     VIAM_SDK_LOG(error) << "do_command not implemented";
     return viam::sdk::ProtoStruct();
 }
 
-void Microphone::get_audio(std::string const& codec,
-                           std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
-                           double const& duration_seconds,
-                           int64_t const& previous_timestamp,
-                           const viam::sdk::ProtoStruct& extra) {
-    VIAM_SDK_LOG(debug) << "get_audio called";
-
-    // Parse codec string to enum
-    const AudioCodec codec_enum = audio::codec::parse_codec(codec);
-
-    // guard to increment and decrement the active stream count
-    StreamGuard stream_guard(stream_ctx_mu_, active_streams_);
-
+template <audio::codec::AudioCodec Codec>
+void Microphone::stream_chunks(std::string const& codec,
+                               std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
+                               double const& duration_seconds,
+                               int64_t const& previous_timestamp,
+                               std::shared_ptr<audio::InputStreamContext> stream_context,
+                               uint64_t read_position,
+                               SilenceGate gate) {
     // Track audio duration using timestamps
     int64_t first_chunk_start_timestamp_ns = 0;
     bool duration_limit_set = false;
 
     uint64_t sequence = 0;
 
-    // Track which context we're reading from to detect any device config changes
-    std::shared_ptr<audio::InputStreamContext> stream_context;
-    uint64_t read_position = 0;
-
-    {
-        std::lock_guard<std::mutex> lock(stream_ctx_mu_);
-        if (!audio_context_) {
-            VIAM_SDK_LOG(error) << "Audio stream not initialized - audio_context_ is null";
-            throw std::runtime_error("Audio stream not initialized");
-        }
-        stream_context = audio_context_;
-    }
-
-    // Initialize read position based on timestamp param
-    read_position = get_initial_read_position(stream_context, previous_timestamp);
-
     // Get sample rate and channels - will be updated if context changes
     int stream_sample_rate = 0;  // Device's native sample rate
     int stream_num_channels = 0;
     int stream_historical_throttle_ms = 0;
+    int stream_catchup_max_chunk_bytes = 0;
     int requested_sample_rate = 0;
     int samples_per_chunk = 0;
     int device_samples_per_chunk = 0;
 
+    // Output bytes each input sample becomes, for sizing coalesced catch-up
+    // reads. MP3 output is smaller than its PCM input, so bounding by the
+    // int16 source size keeps those chunks under the cap too.
+    constexpr int bytes_per_output_sample = (Codec == AudioCodec::PCM_32 || Codec == AudioCodec::PCM_32_FLOAT) ? 4 : 2;
+
+    // Stay trivially empty for the instantiations that don't use them - only
+    // the matching codec's setup and encode paths ever initialize one
     MP3EncoderContext mp3_ctx;
+    OpusEncoderContext opus_ctx;
     uint64_t last_chunk_end_position;
     uint64_t last_logged_overflow_count = 0;
     uint64_t last_logged_underflow_count = 0;
     uint64_t last_staleness_log_ns = 0;
 
     // Setup initial stream parameters and initialize encoder
-    setup_stream_params(codec_enum,
+    setup_stream_params(Codec,
                         mp3_ctx,
+                        opus_ctx,
                         false,
                         stream_sample_rate,
                         requested_sample_rate,
                         stream_num_channels,
                         stream_historical_throttle_ms,
+                        stream_catchup_max_chunk_bytes,
                         samples_per_chunk,
                         device_samples_per_chunk);
 
+    // Persistent resampler for this session - created once so filter state
+    // carries across chunk boundaries instead of re-designing the filter per chunk
+    std::unique_ptr<audio::Resampler> resampler;
+    if (requested_sample_rate != stream_sample_rate) {
+        resampler = std::make_unique<audio::Resampler>(stream_sample_rate, requested_sample_rate, stream_num_channels);
+    }
+
+    // Scratch buffers reused across iterations so the steady-state loop does
+    // not allocate. The only per-chunk allocation left is audio_data itself,
+    // whose ownership transfers to the chunk handler.
+    std::vector<int16_t> temp_buffer(device_samples_per_chunk);
+    std::vector<int16_t> final_buffer;
+    // Opus-only: unaligned tail carried between iterations. The resampler's
+    // per-chunk output count varies (the first chunk comes up short by the
+    // filter delay), but opus_encode only accepts exact 20ms frames, so each
+    // iteration encodes whole frames and holds the tail for the next chunk.
+    std::vector<int16_t> opus_remainder;
+
     while (true) {
-        // Check if audio_context_ changed
+        // Detect context change (device reconfigured or stream restarted)
+        // with a single atomic load - stream_ctx_mu_ stays untouched on the
+        // steady-state path and is only taken on the rare transition itself
         bool context_changed = false;
-        PaStream* current_stream = nullptr;
-        {
-            std::lock_guard<std::mutex> lock(stream_ctx_mu_);
-
-            // Detect context change (device reconfigured or stream restarted)
-            if (audio_context_ != stream_context) {
+        std::shared_ptr<audio::InputStreamContext> current_context = std::atomic_load(&audio_context_);
+        if (current_context != stream_context) {
+            // Historical sessions keep draining the superseded ring's frozen
+            // history until less than a chunk remains, so replay spanning a
+            // stall restart loses nothing the retired ring still holds
+            const bool draining_history = previous_timestamp != 0 && stream_context != nullptr &&
+                                          stream_context->get_write_position() >=
+                                              read_position + static_cast<uint64_t>(device_samples_per_chunk);
+            if (!draining_history) {
                 if (stream_context != nullptr) {
                     VIAM_SDK_LOG(info) << "Detected stream change";
                     context_changed = true;
                 }
+                const bool resume_contiguously = previous_timestamp != 0 && context_changed;
                 // Switch to new context and reset read position
-                stream_context = audio_context_;
-                read_position = stream_context->get_write_position();
-                restart_attempts_ = 0;
+                stream_context = std::move(current_context);
+                if (resume_contiguously) {
+                    // Pick up from the oldest live sample so the replay stays
+                    // contiguous across the restart
+                    const uint64_t live_write = stream_context->get_write_position();
+                    const uint64_t capacity = static_cast<uint64_t>(stream_context->buffer_capacity);
+                    read_position = live_write > capacity ? live_write - capacity : 0;
+                } else {
+                    read_position = stream_context->get_write_position();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+                    restart_attempts_ = 0;
+                }
                 // Brief gap in audio, but stream continues
             }
-            current_stream = stream_;
         }
 
         // Reconfigure stream parameters if context changed
         if (context_changed) {
-            setup_stream_params(codec_enum,
+            setup_stream_params(Codec,
                                 mp3_ctx,
+                                opus_ctx,
                                 true,
                                 stream_sample_rate,
                                 requested_sample_rate,
                                 stream_num_channels,
                                 stream_historical_throttle_ms,
+                                stream_catchup_max_chunk_bytes,
                                 samples_per_chunk,
                                 device_samples_per_chunk);
+            // Device rate may have changed - rebuild the resampler for the new stream
+            resampler.reset();
+            if (requested_sample_rate != stream_sample_rate) {
+                resampler = std::make_unique<audio::Resampler>(stream_sample_rate, requested_sample_rate, stream_num_channels);
+            }
+            temp_buffer.resize(device_samples_per_chunk);
+            opus_remainder.clear();
             last_logged_overflow_count = 0;
             last_logged_underflow_count = 0;
             last_staleness_log_ns = 0;
@@ -437,64 +986,126 @@ void Microphone::get_audio(std::string const& codec,
 
         // Wait until we have a full chunk worth of samples
         if (available_samples < device_samples_per_chunk) {
-            audio::utils::log_callback_staleness(
-                stream_context->last_callback_time_ns, "[get_audio]", current_stream, last_staleness_log_ns);
-
-            const uint64_t last_cb = stream_context->last_callback_time_ns.load();
-            if (last_cb > 0) {
-                const uint64_t now_ns = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
-                const uint64_t stale_ms = (now_ns - last_cb) / 1'000'000;
-                if (stale_ms > audio::utils::STREAM_RESTART_THRESHOLD_MS) {
-                    VIAM_SDK_LOG(warn) << "[get_audio] Stream stalled for " << stale_ms << "ms, attempting restart";
-                    restart_stalled_stream(stream_context);
-                }
+            // Snapshot the stream handle only on this starved path - the
+            // health checks are the one consumer that needs it
+            PaStream* current_stream = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+                current_stream = stream_;
             }
+            check_stream_health(stream_context, current_stream, last_staleness_log_ns, last_logged_overflow_count,
+                                last_logged_underflow_count);
+
+            // Block until the callback publishes a full chunk instead of
+            // polling. The timeout bounds how often the staleness and xrun
+            // checks above run when the stream has stalled.
+            stream_context->wait_for_write_position(read_position + device_samples_per_chunk,
+                                                    std::chrono::milliseconds(CHUNK_WAIT_TIMEOUT_MS));
+            continue;
+        }
 
-            const uint64_t overflow_count = stream_context->input_overflow_count.load();
-            if (overflow_count != last_logged_overflow_count) {
-                VIAM_SDK_LOG(warn) << "[get_audio] Input overflow detected — " << (overflow_count - last_logged_overflow_count)
-                                   << " new overflow(s), " << overflow_count << " total";
-                last_logged_overflow_count = overflow_count;
+        // Historical catch-up: when a resumed session is more than a second
+        // behind, coalesce the backlog into large multi-chunk reads bounded by
+        // the configured byte cap. Delivery is paced by the chunk handler's
+        // own return cadence, and once the session is within a second of live
+        // audio this collapses back to real-time chunk sizing.
+        int read_target = device_samples_per_chunk;
+        if (previous_timestamp != 0 && stream_catchup_max_chunk_bytes > 0) {
+            const uint64_t one_second_samples = static_cast<uint64_t>(stream_sample_rate) * stream_num_channels;
+            if (available_samples > one_second_samples) {
+                read_target = calculate_catchup_read_size(available_samples, device_samples_per_chunk, stream_sample_rate,
+                                                          requested_sample_rate, bytes_per_output_sample, stream_catchup_max_chunk_bytes);
+                if (static_cast<size_t>(read_target) > temp_buffer.size()) {
+                    temp_buffer.resize(read_target);
+                }
             }
+        }
 
-            const uint64_t underflow_count = stream_context->input_underflow_count.load();
-            if (underflow_count != last_logged_underflow_count) {
-                VIAM_SDK_LOG(warn) << "[get_audio] Input underflow detected — " << (underflow_count - last_logged_underflow_count)
-                                   << " new underflow(s), " << underflow_count << " total";
-                last_logged_underflow_count = underflow_count;
+        uint64_t chunk_start_position = read_position;
+        vsdk::AudioIn::audio_chunk chunk;
+        int samples_read;
+        bool fused_read = false;
+
+        // Fused fast path for PCM codecs: when nothing needs the intermediate
+        // int16 form (no resampler, no silence gate), convert straight out of
+        // the ring's contiguous segments into the final audio_data allocation.
+        // PCM streams then make exactly one pass over the data instead of
+        // ring -> temp_buffer -> audio_data.
+        if constexpr (audio::codec::ChunkEncoder<Codec>::supports_fused_ring_read) {
+            if (!resampler && !gate.enabled()) {
+                const auto encode_start = std::chrono::steady_clock::now();
+                chunk.audio_data.resize(static_cast<size_t>(read_target) * bytes_per_output_sample);
+                samples_read = audio::codec::ChunkEncoder<Codec>::read_from_ring(*stream_context, chunk.audio_data.data(), read_target,
+                                                                                 read_position);
+                if (samples_read < read_target) {
+                    // Shouldn't happen since we checked available_samples, but to be safe
+                    VIAM_SDK_LOG(warn) << "Read fewer samples than expected: " << samples_read << " vs " << read_target;
+                    continue;
+                }
+                stats_.encode_ns_total.fetch_add((std::chrono::steady_clock::now() - encode_start).count(), std::memory_order_relaxed);
+                stats_.encode_chunks.fetch_add(1, std::memory_order_relaxed);
+                fused_read = true;
             }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            continue;
         }
 
-        std::vector<int16_t> temp_buffer(device_samples_per_chunk);
-        uint64_t chunk_start_position = read_position;
-        // Read exactly one chunk worth of samples
-        const int samples_read = stream_context->read_samples(temp_buffer.data(), device_samples_per_chunk, read_position);
+        if (!fused_read) {
+            // Read exactly one delivery worth of samples
+            samples_read = stream_context->read_samples(temp_buffer.data(), read_target, read_position);
 
-        if (samples_read < device_samples_per_chunk) {
-            // Shouldn't happen since we checked available_samples, but to be safe
-            VIAM_SDK_LOG(warn) << "Read fewer samples than expected: " << samples_read << " vs " << device_samples_per_chunk;
-            continue;
-        }
+            if (samples_read < read_target) {
+                // Shouldn't happen since we checked available_samples, but to be safe
+                VIAM_SDK_LOG(warn) << "Read fewer samples than expected: " << samples_read << " vs " << read_target;
+                continue;
+            }
 
-        std::vector<int16_t> final_buffer;
-        int final_sample_count;
-        if (requested_sample_rate != stream_sample_rate) {
-            // Resample from device rate to requested rate
-            resample_audio(stream_sample_rate, requested_sample_rate, stream_num_channels, temp_buffer.data(), samples_read, final_buffer);
-            final_sample_count = final_buffer.size();
-        } else {
-            final_buffer = std::move(temp_buffer);
-            final_sample_count = samples_read;
-        }
+            // Energy gate: drop silent chunks before conversion and delivery.
+            // read_position has already advanced, so timestamps stay continuous.
+            if (!gate.should_deliver(temp_buffer.data(), samples_read)) {
+                continue;
+            }
 
-        vsdk::AudioIn::audio_chunk chunk;
+            int16_t* final_samples;
+            int final_sample_count;
+            if (resampler) {
+                // Resample from device rate to requested rate
+                const auto resample_start = std::chrono::steady_clock::now();
+                resampler->process(temp_buffer.data(), samples_read, final_buffer);
+                stats_.resample_ns_total.fetch_add((std::chrono::steady_clock::now() - resample_start).count(), std::memory_order_relaxed);
+                stats_.resample_chunks.fetch_add(1, std::memory_order_relaxed);
+                final_samples = final_buffer.data();
+                final_sample_count = final_buffer.size();
+            } else {
+                final_samples = temp_buffer.data();
+                final_sample_count = samples_read;
+            }
 
-        // Convert from int16 (captured format) to requested codec
-        audio::codec::encode_audio_chunk(
-            codec_enum, final_buffer.data(), final_sample_count, chunk_start_position, mp3_ctx, chunk.audio_data);
+            // Convert from int16 (captured format) to requested codec - the
+            // specialization is fixed at compile time, so this inlines to the
+            // bare conversion with no dispatch
+            const auto encode_start = std::chrono::steady_clock::now();
+            if constexpr (Codec == AudioCodec::OPUS) {
+                const int samples_per_frame = opus_ctx.frame_size * stream_num_channels;
+                if (opus_remainder.empty() && final_sample_count % samples_per_frame == 0) {
+                    // Aligned chunk (the no-resampler case) - encode in place
+                    audio::codec::ChunkEncoder<Codec>::encode(opus_ctx, final_samples, final_sample_count, chunk_start_position,
+                                                              chunk.audio_data);
+                } else {
+                    opus_remainder.insert(opus_remainder.end(), final_samples, final_samples + final_sample_count);
+                    const int whole_frames_count =
+                        static_cast<int>(opus_remainder.size() / samples_per_frame) * samples_per_frame;
+                    if (whole_frames_count > 0) {
+                        audio::codec::ChunkEncoder<Codec>::encode(opus_ctx, opus_remainder.data(), whole_frames_count,
+                                                                  chunk_start_position, chunk.audio_data);
+                        opus_remainder.erase(opus_remainder.begin(), opus_remainder.begin() + whole_frames_count);
+                    }
+                }
+            } else {
+                audio::codec::ChunkEncoder<Codec>::encode(mp3_ctx, final_samples, final_sample_count, chunk_start_position,
+                                                          chunk.audio_data);
+            }
+            stats_.encode_ns_total.fetch_add((std::chrono::steady_clock::now() - encode_start).count(), std::memory_order_relaxed);
+            stats_.encode_chunks.fetch_add(1, std::memory_order_relaxed);
+        }
 
         chunk.info.codec = codec;
         chunk.info.sample_rate_hz = requested_sample_rate;
@@ -503,17 +1114,32 @@ void Microphone::get_audio(std::string const& codec,
 
         // Calculate timestamps based on sample position in stream
         uint64_t chunk_end_position = chunk_start_position + samples_read;
-        if (codec_enum == AudioCodec::MP3 && mp3_ctx.encoder) {
-            // Aadjust for encoder delay since decoded output will be shifted
-            const int delay_samples = mp3_ctx.encoder_delay * stream_num_channels;
-            // Timestamps should reflect the data the encoder returned,
-            // adjust for encoder delay
-            if (chunk_start_position >= delay_samples) {
-                chunk_start_position -= delay_samples;
-            } else {
-                chunk_start_position = 0;
+        if constexpr (Codec == AudioCodec::MP3) {
+            if (mp3_ctx.encoder) {
+                // Aadjust for encoder delay since decoded output will be shifted
+                const int delay_samples = mp3_ctx.encoder_delay * stream_num_channels;
+                // Timestamps should reflect the data the encoder returned,
+                // adjust for encoder delay
+                if (chunk_start_position >= delay_samples) {
+                    chunk_start_position -= delay_samples;
+                } else {
+                    chunk_start_position = 0;
+                }
+                chunk_end_position -= delay_samples;
+            }
+        }
+        if constexpr (Codec == AudioCodec::OPUS) {
+            if (opus_ctx.encoder) {
+                // Same adjustment for Opus - its lookahead shifts decoded
+                // output just like LAME's encoder delay
+                const int delay_samples = opus_ctx.encoder_delay * stream_num_channels;
+                if (chunk_start_position >= delay_samples) {
+                    chunk_start_position -= delay_samples;
+                } else {
+                    chunk_start_position = 0;
+                }
+                chunk_end_position -= delay_samples;
             }
-            chunk_end_position -= delay_samples;
         }
 
         chunk.start_timestamp_ns = stream_context->calculate_sample_timestamp(chunk_start_position);
@@ -543,14 +1169,20 @@ void Microphone::get_audio(std::string const& codec,
             }
         }
 
-        if (!chunk_handler(std::move(chunk))) {
+        const auto delivery_start = std::chrono::steady_clock::now();
+        const bool keep_streaming = chunk_handler(std::move(chunk));
+        stats_.delivery_ns_total.fetch_add((std::chrono::steady_clock::now() - delivery_start).count(), std::memory_order_relaxed);
+        stats_.delivered_chunks.fetch_add(1, std::memory_order_relaxed);
+        if (!keep_streaming) {
             // If the chunk callback returned false, the stream has ended
             VIAM_RESOURCE_LOG(info) << "Chunk handler returned false, client disconnected";
             return;
         }
 
-        // Check if we're reading historical data (far behind write position)
-        if (previous_timestamp != 0) {
+        // Check if we're reading historical data (far behind write position).
+        // The fixed throttle sleep only applies when coalescing is disabled -
+        // coalesced catch-up is paced by the handler return above instead.
+        if (previous_timestamp != 0 && stream_catchup_max_chunk_bytes <= 0) {
             const uint64_t current_write_pos = stream_context->get_write_position();
             const uint64_t distance_behind = current_write_pos - read_position;
             // If we're more than 1 second behind, we're reading historical data
@@ -564,7 +1196,526 @@ void Microphone::get_audio(std::string const& codec,
 
     // Flush MP3 encoder at end of the stream to ensure all recorded audio
     // is returned
-    if (codec_enum == AudioCodec::MP3 && mp3_ctx.encoder) {
+    if constexpr (Codec == AudioCodec::MP3) {
+        if (mp3_ctx.encoder) {
+            std::vector<uint8_t> final_data;
+            flush_mp3_encoder(mp3_ctx, final_data);
+
+            if (!final_data.empty()) {
+                const size_t final_data_size = final_data.size();
+                vsdk::AudioIn::audio_chunk final_chunk;
+                final_chunk.audio_data = std::move(final_data);
+                final_chunk.info.codec = codec;
+                final_chunk.info.sample_rate_hz = requested_sample_rate;
+                final_chunk.info.num_channels = stream_num_channels;
+                final_chunk.sequence_number = sequence++;
+
+                // Since our chunk sizes are aligned with the frame size,
+                // there will be delay_samples flushed from the encoder buffer
+                const int delay_samples = mp3_ctx.encoder_delay * stream_num_channels;
+                const uint64_t timestamp_start = last_chunk_end_position;
+                const uint64_t timestamp_end = last_chunk_end_position + delay_samples;
+
+                VIAM_SDK_LOG(debug) << "Flush: last_chunk_end=" << last_chunk_end_position << " encoder_delay=" << mp3_ctx.encoder_delay
+                                    << " samples (" << delay_samples << " total)"
+                                    << " timestamp_start=" << timestamp_start << " timestamp_end=" << timestamp_end
+                                    << " flush_duration_samples=" << (timestamp_end - timestamp_start);
+
+                final_chunk.start_timestamp_ns = stream_context->calculate_sample_timestamp(timestamp_start);
+                final_chunk.end_timestamp_ns = stream_context->calculate_sample_timestamp(timestamp_end);
+
+                chunk_handler(std::move(final_chunk));
+                VIAM_SDK_LOG(debug) << "Sent final MP3 flush chunk with " << final_data_size << " bytes";
+            }
+        }
+    }
+
+    VIAM_SDK_LOG(debug) << "get_audio stream completed";
+}
+
+void Microphone::get_audio(std::string const& codec,
+                           std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
+                           double const& duration_seconds,
+                           int64_t const& previous_timestamp,
+                           const viam::sdk::ProtoStruct& extra) {
+    VIAM_SDK_LOG(debug) << "get_audio called";
+
+    // Parse codec string to enum
+    const AudioCodec codec_enum = audio::codec::parse_codec(codec);
+
+    // guard to increment and decrement the active stream count
+    StreamGuard stream_guard(active_streams_);
+
+    // Track which context we're reading from to detect any device config changes
+    std::shared_ptr<audio::InputStreamContext> stream_context = std::atomic_load(&audio_context_);
+    if (!stream_context) {
+        VIAM_SDK_LOG(error) << "Audio stream not initialized - audio_context_ is null";
+        throw std::runtime_error("Audio stream not initialized");
+    }
+
+    // Historical sessions whose timestamp predates the live context resolve
+    // against the ring retained by the last stall restart: the streaming loop
+    // drains its frozen history, then rolls onto the live context
+    if (auto retired = retired_context_covering(previous_timestamp)) {
+        stream_context = std::move(retired);
+    }
+
+    // Initialize read position based on timestamp param
+    const uint64_t read_position = get_initial_read_position(stream_context, previous_timestamp);
+
+    // Build the session's silence gate from config, with a per-call override
+    bool silence_enabled = false;
+    double silence_threshold_rms = DEFAULT_SILENCE_THRESHOLD_RMS;
+    int silence_hang_ms = DEFAULT_SILENCE_HANG_MS;
+    {
+        std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+        silence_enabled = silence_suppression_;
+        silence_threshold_rms = silence_threshold_rms_;
+        silence_hang_ms = silence_hang_ms_;
+    }
+    if (extra.count("silence_suppression")) {
+        const bool* flag = extra.at("silence_suppression").get<bool>();
+        if (flag != nullptr) {
+            silence_enabled = *flag;
+        }
+    }
+    const SilenceGate gate(silence_enabled, silence_threshold_rms, silence_hang_ms);
+
+    // Bind the codec specialization once; everything per-chunk runs inside
+    // stream_chunks with the codec fixed at compile time
+    switch (codec_enum) {
+        case AudioCodec::PCM_16:
+            stream_chunks<AudioCodec::PCM_16>(
+                codec, chunk_handler, duration_seconds, previous_timestamp, std::move(stream_context), read_position, gate);
+            break;
+        case AudioCodec::PCM_32:
+            stream_chunks<AudioCodec::PCM_32>(
+                codec, chunk_handler, duration_seconds, previous_timestamp, std::move(stream_context), read_position, gate);
+            break;
+        case AudioCodec::PCM_32_FLOAT:
+            stream_chunks<AudioCodec::PCM_32_FLOAT>(
+                codec, chunk_handler, duration_seconds, previous_timestamp, std::move(stream_context), read_position, gate);
+            break;
+        case AudioCodec::MP3:
+            if (previous_timestamp != 0) {
+                // Historical resume needs a private encoder running from the
+                // requested position - only live sessions share the encode stage
+                stream_mp3_chunks_pipelined(
+                    codec, chunk_handler, duration_seconds, previous_timestamp, std::move(stream_context), read_position, gate);
+            } else {
+                stream_shared_mp3_chunks(codec, chunk_handler, duration_seconds, std::move(stream_context), gate);
+            }
+            break;
+        case AudioCodec::OPUS:
+            stream_chunks<AudioCodec::OPUS>(
+                codec, chunk_handler, duration_seconds, previous_timestamp, std::move(stream_context), read_position, gate);
+            break;
+    }
+}
+
+std::shared_ptr<SharedMP3Encoder> Microphone::acquire_shared_mp3_encoder(
+    const std::shared_ptr<audio::InputStreamContext>& stream_context) {
+    std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+    if (shared_mp3_encoder_ && shared_mp3_encoder_->stream_context() == stream_context &&
+        shared_mp3_encoder_->sample_rate() == requested_sample_rate_ &&
+        shared_mp3_encoder_->num_channels() == stream_params_.num_channels) {
+        return shared_mp3_encoder_;
+    }
+    shared_mp3_encoder_ = std::make_shared<SharedMP3Encoder>(
+        stream_context, stream_params_.sample_rate, requested_sample_rate_, stream_params_.num_channels, &stats_);
+    return shared_mp3_encoder_;
+}
+
+void Microphone::stream_shared_mp3_chunks(std::string const& codec,
+                                          std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
+                                          double const& duration_seconds,
+                                          std::shared_ptr<audio::InputStreamContext> stream_context,
+                                          SilenceGate gate) {
+    // Track audio duration using timestamps
+    int64_t first_chunk_start_timestamp_ns = 0;
+    bool duration_limit_set = false;
+
+    uint64_t sequence = 0;
+
+    std::shared_ptr<SharedMP3Encoder> encoder = acquire_shared_mp3_encoder(stream_context);
+    uint64_t cursor = encoder->next_sequence();
+
+    int requested_sample_rate = 0;
+    int stream_num_channels = 0;
+    {
+        std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+        requested_sample_rate = requested_sample_rate_;
+        stream_num_channels = stream_params_.num_channels;
+    }
+
+    uint64_t last_logged_overflow_count = 0;
+    uint64_t last_logged_underflow_count = 0;
+    uint64_t last_staleness_log_ns = 0;
+
+    while (true) {
+        // Detect context change (device reconfigured or stream restarted)
+        // with a single atomic load, keeping stream_ctx_mu_ off the
+        // steady-state path
+        bool context_changed = false;
+        std::shared_ptr<audio::InputStreamContext> current_context = std::atomic_load(&audio_context_);
+        if (current_context != stream_context) {
+            VIAM_SDK_LOG(info) << "Detected stream change";
+            context_changed = true;
+            stream_context = std::move(current_context);
+            {
+                std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+                restart_attempts_ = 0;
+            }
+            // Brief gap in audio, but stream continues
+        }
+
+        // Rebind to the encoder for the new capture context
+        if (context_changed) {
+            encoder = acquire_shared_mp3_encoder(stream_context);
+            cursor = encoder->next_sequence();
+            {
+                std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+                requested_sample_rate = requested_sample_rate_;
+                stream_num_channels = stream_params_.num_channels;
+            }
+            last_logged_overflow_count = 0;
+            last_logged_underflow_count = 0;
+            last_staleness_log_ns = 0;
+        }
+
+        EncodedMP3Chunk encoded;
+        if (!encoder->get_chunk(cursor, encoded, std::chrono::milliseconds(CHUNK_WAIT_TIMEOUT_MS))) {
+            // No chunk arrived - run the same staleness and xrun checks as the PCM loop
+            PaStream* current_stream = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+                current_stream = stream_;
+            }
+            check_stream_health(stream_context, current_stream, last_staleness_log_ns, last_logged_overflow_count,
+                                last_logged_underflow_count);
+            continue;
+        }
+        cursor = encoded.sequence + 1;
+
+        // The shared stage already encoded this chunk for the other sessions,
+        // so the gate here saves transmission rather than encode CPU
+        if (!gate.should_deliver(encoded.rms)) {
+            continue;
+        }
+
+        vsdk::AudioIn::audio_chunk chunk;
+        chunk.audio_data = std::move(encoded.data);
+        chunk.info.codec = codec;
+        chunk.info.sample_rate_hz = requested_sample_rate;
+        chunk.info.num_channels = stream_num_channels;
+        chunk.sequence_number = sequence++;
+
+        chunk.start_timestamp_ns = stream_context->calculate_sample_timestamp(encoded.start_position);
+        chunk.end_timestamp_ns = stream_context->calculate_sample_timestamp(encoded.end_position);
+
+        // Set audio duration limit after first chunk (save the starting timestamp)
+        if (!duration_limit_set && duration_seconds > 0) {
+            first_chunk_start_timestamp_ns = chunk.start_timestamp_ns.count();
+            duration_limit_set = true;
+            VIAM_SDK_LOG(debug) << "Audio duration limit set: will read " << duration_seconds << " seconds starting from timestamp "
+                                << first_chunk_start_timestamp_ns;
+        }
+
+        // Check if we've read enough audio (only if duration limit is set)
+        if (duration_limit_set) {
+            const int64_t time_elapsed_ns = chunk.end_timestamp_ns.count() - first_chunk_start_timestamp_ns;
+            const double time_elapsed_seconds = time_elapsed_ns / 1e9;
+
+            if (time_elapsed_seconds >= duration_seconds) {
+                VIAM_SDK_LOG(debug) << "Reached audio duration limit: read " << time_elapsed_seconds << "s, limit was " << duration_seconds
+                                    << "s";
+                // Send final chunk before exiting
+                chunk_handler(std::move(chunk));
+                break;
+            }
+        }
+
+        if (!chunk_handler(std::move(chunk))) {
+            // If the chunk callback returned false, the stream has ended
+            VIAM_RESOURCE_LOG(info) << "Chunk handler returned false, client disconnected";
+            return;
+        }
+    }
+
+    // The shared encoder keeps running for the other sessions, so there is no
+    // per-session flush chunk: the final ~encoder_delay samples stay in the
+    // shared LAME lookahead until more audio is encoded
+    VIAM_SDK_LOG(debug) << "get_audio stream completed";
+}
+
+void Microphone::stream_mp3_chunks_pipelined(std::string const& codec,
+                                             std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
+                                             double const& duration_seconds,
+                                             int64_t const& previous_timestamp,
+                                             std::shared_ptr<audio::InputStreamContext> stream_context,
+                                             uint64_t read_position,
+                                             SilenceGate gate) {
+    // Track audio duration using timestamps (owned by the encoder stage)
+    int64_t first_chunk_start_timestamp_ns = 0;
+    bool duration_limit_set = false;
+
+    uint64_t sequence = 0;
+
+    // Get sample rate and channels - will be updated if context changes
+    int stream_sample_rate = 0;  // Device's native sample rate
+    int stream_num_channels = 0;
+    int stream_historical_throttle_ms = 0;
+    int stream_catchup_max_chunk_bytes = 0;
+    int requested_sample_rate = 0;
+    int samples_per_chunk = 0;
+    int device_samples_per_chunk = 0;
+
+    MP3EncoderContext mp3_ctx;
+    // Unused on this MP3-only path but required by the shared setup signature
+    OpusEncoderContext opus_ctx;
+    uint64_t last_chunk_end_position = 0;
+    uint64_t last_logged_overflow_count = 0;
+    uint64_t last_logged_underflow_count = 0;
+    uint64_t last_staleness_log_ns = 0;
+
+    std::unique_ptr<audio::Resampler> resampler;
+    std::vector<int16_t> final_buffer;
+
+    bool is_reconfigure = false;
+    while (true) {
+        setup_stream_params(AudioCodec::MP3,
+                            mp3_ctx,
+                            opus_ctx,
+                            is_reconfigure,
+                            stream_sample_rate,
+                            requested_sample_rate,
+                            stream_num_channels,
+                            stream_historical_throttle_ms,
+                            stream_catchup_max_chunk_bytes,
+                            samples_per_chunk,
+                            device_samples_per_chunk);
+        is_reconfigure = true;
+
+        resampler.reset();
+        if (requested_sample_rate != stream_sample_rate) {
+            resampler = std::make_unique<audio::Resampler>(stream_sample_rate, requested_sample_rate, stream_num_channels);
+        }
+        last_logged_overflow_count = 0;
+        last_logged_underflow_count = 0;
+        last_staleness_log_ns = 0;
+
+        // Two-stage pipeline: this thread reads chunks from the capture ring
+        // into a bounded queue and the encoder thread drains it, so a slow
+        // LAME frame consumes queue slack instead of delaying the next ring
+        // read. The pipeline is torn down and rebuilt on context change.
+        BoundedChunkQueue queue(PIPELINE_QUEUE_DEPTH);
+        std::atomic<bool> stop_reading{false};
+        std::atomic<bool> handler_stopped{false};
+        std::atomic<bool> duration_reached{false};
+        std::exception_ptr encoder_exception;
+
+        std::thread encoder_thread([&] {
+            try {
+                PipelinedChunk item;
+                while (queue.pop(item)) {
+                    int16_t* final_samples = item.samples.data();
+                    int final_sample_count = item.sample_count;
+                    if (resampler) {
+                        // Resample from device rate to requested rate
+                        resampler->process(item.samples.data(), item.sample_count, final_buffer);
+                        final_samples = final_buffer.data();
+                        final_sample_count = static_cast<int>(final_buffer.size());
+                    }
+
+                    vsdk::AudioIn::audio_chunk chunk;
+                    audio::codec::ChunkEncoder<AudioCodec::MP3>::encode(
+                        mp3_ctx, final_samples, final_sample_count, item.start_position, chunk.audio_data);
+
+                    chunk.info.codec = codec;
+                    chunk.info.sample_rate_hz = requested_sample_rate;
+                    chunk.info.num_channels = stream_num_channels;
+                    chunk.sequence_number = sequence++;
+
+                    // Calculate timestamps based on sample position in stream
+                    uint64_t chunk_start_position = item.start_position;
+                    uint64_t chunk_end_position = chunk_start_position + item.sample_count;
+                    if (mp3_ctx.encoder) {
+                        // Timestamps should reflect the data the encoder
+                        // returned - adjust for encoder delay
+                        const int delay_samples = mp3_ctx.encoder_delay * stream_num_channels;
+                        if (chunk_start_position >= delay_samples) {
+                            chunk_start_position -= delay_samples;
+                        } else {
+                            chunk_start_position = 0;
+                        }
+                        chunk_end_position -= delay_samples;
+                    }
+
+                    chunk.start_timestamp_ns = stream_context->calculate_sample_timestamp(chunk_start_position);
+                    chunk.end_timestamp_ns = stream_context->calculate_sample_timestamp(chunk_end_position);
+
+                    last_chunk_end_position = chunk_end_position;
+
+                    // Set audio duration limit after first chunk
+                    if (!duration_limit_set && duration_seconds > 0) {
+                        first_chunk_start_timestamp_ns = chunk.start_timestamp_ns.count();
+                        duration_limit_set = true;
+                        VIAM_SDK_LOG(debug) << "Audio duration limit set: will read " << duration_seconds
+                                            << " seconds starting from timestamp " << first_chunk_start_timestamp_ns;
+                    }
+
+                    if (duration_limit_set) {
+                        const int64_t time_elapsed_ns = chunk.end_timestamp_ns.count() - first_chunk_start_timestamp_ns;
+                        const double time_elapsed_seconds = time_elapsed_ns / 1e9;
+
+                        if (time_elapsed_seconds >= duration_seconds) {
+                            VIAM_SDK_LOG(debug) << "Reached audio duration limit: read " << time_elapsed_seconds << "s, limit was "
+                                                << duration_seconds << "s";
+                            // Send final chunk before exiting
+                            chunk_handler(std::move(chunk));
+                            duration_reached.store(true);
+                            stop_reading.store(true);
+                            break;
+                        }
+                    }
+
+                    if (!chunk_handler(std::move(chunk))) {
+                        // If the chunk callback returned false, the stream has ended
+                        VIAM_RESOURCE_LOG(info) << "Chunk handler returned false, client disconnected";
+                        handler_stopped.store(true);
+                        stop_reading.store(true);
+                        break;
+                    }
+
+                    queue.recycle(std::move(item.samples));
+                }
+            } catch (...) {
+                encoder_exception = std::current_exception();
+                stop_reading.store(true);
+            }
+            // Unblock the reader if it is waiting on a full queue
+            queue.close();
+        });
+
+        // Reader stage: pull chunks from the capture ring at capture cadence
+        bool context_changed = false;
+        while (!stop_reading.load()) {
+            // Detect context change (device reconfigured or stream restarted)
+            // with a single atomic load and rebuild the pipeline against the
+            // new context. Keep draining the superseded ring's frozen history
+            // first so replay spanning a stall restart loses nothing.
+            if (std::atomic_load(&audio_context_) != stream_context &&
+                stream_context->get_write_position() < read_position + static_cast<uint64_t>(device_samples_per_chunk)) {
+                context_changed = true;
+                break;
+            }
+
+            const uint64_t write_pos = stream_context->get_write_position();
+            const uint64_t available_samples = write_pos - read_position;
+
+            // Wait until we have a full chunk worth of samples
+            if (available_samples < device_samples_per_chunk) {
+                PaStream* current_stream = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+                    current_stream = stream_;
+                }
+                check_stream_health(stream_context, current_stream, last_staleness_log_ns, last_logged_overflow_count,
+                                    last_logged_underflow_count);
+                stream_context->wait_for_write_position(read_position + device_samples_per_chunk,
+                                                        std::chrono::milliseconds(CHUNK_WAIT_TIMEOUT_MS));
+                continue;
+            }
+
+            // Historical catch-up: coalesce the backlog into large
+            // frame-aligned reads bounded by the byte cap, paced by the
+            // encoder stage draining the queue rather than a fixed sleep.
+            // Bounding by the int16 source size keeps the encoded output
+            // under the cap, since MP3 compresses its input.
+            int read_target = device_samples_per_chunk;
+            if (previous_timestamp != 0 && stream_catchup_max_chunk_bytes > 0) {
+                const uint64_t one_second_samples = static_cast<uint64_t>(stream_sample_rate) * stream_num_channels;
+                if (available_samples > one_second_samples) {
+                    read_target = calculate_catchup_read_size(available_samples, device_samples_per_chunk, stream_sample_rate,
+                                                              requested_sample_rate, sizeof(int16_t), stream_catchup_max_chunk_bytes);
+                }
+            }
+
+            PipelinedChunk item;
+            item.samples = queue.take_buffer();
+            item.samples.resize(read_target);
+            const uint64_t chunk_start_position = read_position;
+            const int samples_read = stream_context->read_samples(item.samples.data(), read_target, read_position);
+
+            if (samples_read < read_target) {
+                // Shouldn't happen since we checked available_samples, but to be safe
+                VIAM_SDK_LOG(warn) << "Read fewer samples than expected: " << samples_read << " vs " << read_target;
+                continue;
+            }
+            item.sample_count = samples_read;
+            item.start_position = chunk_start_position;
+
+            // Energy gate: drop silent chunks before they reach the encoder
+            // stage, skipping the LAME encode entirely
+            if (!gate.should_deliver(item.samples.data(), samples_read)) {
+                queue.recycle(std::move(item.samples));
+                continue;
+            }
+
+            if (!queue.push(std::move(item))) {
+                // The encoder stage exited and closed the queue
+                break;
+            }
+
+            // Check if we're reading historical data (far behind write
+            // position). The fixed throttle sleep only applies when coalescing
+            // is disabled - coalesced catch-up is paced by the bounded queue
+            // and the handler return cadence instead.
+            if (previous_timestamp != 0 && stream_catchup_max_chunk_bytes <= 0) {
+                const uint64_t current_write_pos = stream_context->get_write_position();
+                const uint64_t distance_behind = current_write_pos - read_position;
+                // If we're more than 1 second behind, we're reading historical data
+                const uint64_t one_second_samples = stream_sample_rate * stream_num_channels;
+                if (distance_behind > one_second_samples) {
+                    // Throttle historical data to give clients time to process
+                    std::this_thread::sleep_for(std::chrono::milliseconds(stream_historical_throttle_ms));
+                }
+            }
+        }
+
+        queue.close();
+        encoder_thread.join();
+
+        if (encoder_exception) {
+            std::rethrow_exception(encoder_exception);
+        }
+        if (handler_stopped.load()) {
+            return;
+        }
+        if (duration_reached.load()) {
+            break;
+        }
+        if (context_changed) {
+            VIAM_SDK_LOG(info) << "Detected stream change";
+            stream_context = std::atomic_load(&audio_context_);
+            // This path always serves a historical resume, so pick up from the
+            // oldest live sample to keep the replay contiguous
+            const uint64_t live_write = stream_context->get_write_position();
+            const uint64_t capacity = static_cast<uint64_t>(stream_context->buffer_capacity);
+            read_position = live_write > capacity ? live_write - capacity : 0;
+            {
+                std::lock_guard<std::mutex> lock(stream_ctx_mu_);
+                restart_attempts_ = 0;
+            }
+            // Brief gap in audio, but stream continues
+            continue;
+        }
+        break;
+    }
+
+    // Flush MP3 encoder at end of the stream to ensure all recorded audio
+    // is returned
+    if (mp3_ctx.encoder) {
         std::vector<uint8_t> final_data;
         flush_mp3_encoder(mp3_ctx, final_data);
 
@@ -602,8 +1753,11 @@ void Microphone::get_audio(std::string const& codec,
 viam::sdk::audio_properties Microphone::get_properties(const viam::sdk::ProtoStruct& extra) {
     viam::sdk::audio_properties props;
 
-    props.supported_codecs = {
-        vsdk::audio_codecs::PCM_16, vsdk::audio_codecs::PCM_32, vsdk::audio_codecs::PCM_32_FLOAT, vsdk::audio_codecs::MP3};
+    props.supported_codecs = {vsdk::audio_codecs::PCM_16,
+                              vsdk::audio_codecs::PCM_32,
+                              vsdk::audio_codecs::PCM_32_FLOAT,
+                              vsdk::audio_codecs::MP3,
+                              audio::codec::OPUS_CODEC_NAME};
     std::lock_guard<std::mutex> lock(stream_ctx_mu_);
     props.sample_rate_hz = requested_sample_rate_;  // Return requested rate (what user will actually receive)
     props.num_channels = stream_params_.num_channels;
@@ -663,9 +1817,11 @@ uint64_t get_initial_read_position(const std::shared_ptr<audio::InputStreamConte
 
     // Validate timestamp is not too old (audio has been overwritten)
     if (current_write_pos > read_position + stream_context->buffer_capacity) {
+        const int history_seconds =
+            stream_context->buffer_capacity / (stream_context->info.sample_rate_hz * stream_context->info.num_channels);
         std::ostringstream buffer;
         buffer << "requested timestamp is too old - audio has been overwritten. "
-               << "Buffer only holds " << audio::BUFFER_DURATION_SECONDS << " seconds of audio history.";
+               << "Buffer only holds " << history_seconds << " seconds of audio history.";
         VIAM_SDK_LOG(error) << buffer.str();
         throw std::invalid_argument(buffer.str());
     }
@@ -723,7 +1879,12 @@ int AudioCallback(const void* inputBuffer,
         return paAbort;
     }
 
-    ctx->last_callback_time_ns.store(static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    const uint64_t now_ns = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const uint64_t prev_ns = ctx->last_callback_time_ns.exchange(now_ns);
+    if (prev_ns > 0) {
+        // One relaxed bucket increment - RT-safe jitter tracking
+        ctx->callback_interval_histogram.record(now_ns - prev_ns);
+    }
 
     if (statusFlags & paInputOverflow) {
         ctx->input_overflow_count.fetch_add(1);
@@ -736,8 +1897,6 @@ int AudioCallback(const void* inputBuffer,
         return paContinue;
     }
 
-    const int16_t* input = static_cast<const int16_t*>(inputBuffer);
-
     // First callback: establish anchor between PortAudio time and wall-clock time
     if (!ctx->first_callback_captured.load()) {
         // the inputBufferADCTime describes the time when the
@@ -750,10 +1909,40 @@ int AudioCallback(const void* inputBuffer,
 
     const uint64_t total_samples = framesPerBuffer * ctx->info.num_channels;
 
-    for (int i = 0; i < total_samples; ++i) {
-        ctx->write_sample(input[i]);
+    if (ctx->sample_format == paInt16) {
+        // Block-copy the whole callback buffer into the ring - one release-store
+        // per callback instead of two atomic RMWs per sample
+        ctx->write_samples(static_cast<const int16_t*>(inputBuffer), total_samples);
+    } else {
+        // The stream was negotiated to the device's wider native format, so
+        // PortAudio hands us raw samples and we do the single down-conversion
+        // to the pcm16 ring here. Fixed stack scratch buffer - no allocation.
+        int16_t scratch[1024];
+        uint64_t converted = 0;
+        while (converted < total_samples) {
+            const size_t chunk = std::min<uint64_t>(total_samples - converted, sizeof(scratch) / sizeof(scratch[0]));
+            switch (ctx->sample_format) {
+                case paInt32:
+                    audio::codec::convert_int32_to_pcm16(static_cast<const int32_t*>(inputBuffer) + converted, scratch, chunk);
+                    break;
+                case paInt24:
+                    audio::codec::convert_int24_to_pcm16(static_cast<const uint8_t*>(inputBuffer) + converted * 3, scratch, chunk);
+                    break;
+                case paFloat32:
+                    audio::codec::convert_float32_to_pcm16_samples(static_cast<const float*>(inputBuffer) + converted, scratch, chunk);
+                    break;
+                default:
+                    // Unknown format - drop the buffer rather than write garbage
+                    return paContinue;
+            }
+            ctx->write_samples(scratch, chunk);
+            converted += chunk;
+        }
     }
 
+    // Wake any get_audio readers blocked waiting for a full chunk
+    ctx->notify_samples_written();
+
     return paContinue;
 }
 
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -13,6 +18,8 @@
 #include "audio_codec.hpp"
 #include "audio_stream.hpp"
 #include "audio_utils.hpp"
+#include "resample.hpp"
+#include "stream_supervisor.hpp"
 #include "portaudio.h"
 #include "portaudio.hpp"
 
@@ -21,6 +28,65 @@ namespace vsdk = ::viam::sdk;
 
 constexpr double DEFAULT_HISTORICAL_THROTTLE_MS = 50;
 constexpr int MAX_STREAM_RESTART_ATTEMPTS = 3;
+// Upper bound on how long get_audio blocks waiting for a chunk before
+// re-running its staleness and xrun checks
+constexpr int CHUNK_WAIT_TIMEOUT_MS = 100;
+// Depth of the bounded queue between the reader and encoder stages of a
+// pipelined mp3 session - a few chunks of slack so an encode spike does not
+// delay the next ring read, without unbounded memory or latency
+constexpr int PIPELINE_QUEUE_DEPTH = 4;
+// Defaults for the opt-in silence suppression gate: roughly -40 dBFS
+// threshold and one second of hang time after the last loud chunk
+constexpr double DEFAULT_SILENCE_THRESHOLD_RMS = 0.01;
+constexpr int DEFAULT_SILENCE_HANG_MS = 1000;
+// Cap on the output bytes of a single coalesced chunk while a session with
+// previous_timestamp catches up on backlog. 0 disables coalescing and falls
+// back to single-chunk replay throttled by historical_throttle_ms.
+constexpr int DEFAULT_CATCHUP_MAX_CHUNK_BYTES = 1 << 20;
+
+// Per-session energy gate for silence suppression. When enabled, chunks whose
+// RMS level stays below the threshold beyond the hang time are dropped before
+// encode and transmission. Timestamps are derived from ring positions, so
+// previous_timestamp resume is unaffected by dropped chunks.
+class SilenceGate {
+   public:
+    SilenceGate() = default;
+    SilenceGate(bool enabled, double threshold_rms, int hang_ms)
+        : enabled_(enabled), threshold_rms_(threshold_rms), hang_ms_(hang_ms) {}
+
+    bool enabled() const { return enabled_; }
+
+    // Returns true if a chunk with the given RMS level should be delivered
+    bool should_deliver(double rms) {
+        if (!enabled_) {
+            return true;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (rms >= threshold_rms_) {
+            last_loud_time_ = now;
+            loud_seen_ = true;
+            return true;
+        }
+        // Keep delivering through the hang window so speech pauses and decay
+        // tails are not clipped
+        return loud_seen_ && (now - last_loud_time_) <= std::chrono::milliseconds(hang_ms_);
+    }
+
+    // Convenience overload that skips the RMS pass entirely when disabled
+    bool should_deliver(const int16_t* samples, int sample_count) {
+        if (!enabled_) {
+            return true;
+        }
+        return should_deliver(audio::codec::compute_rms(samples, sample_count));
+    }
+
+   private:
+    bool enabled_ = false;
+    double threshold_rms_ = DEFAULT_SILENCE_THRESHOLD_RMS;
+    int hang_ms_ = DEFAULT_SILENCE_HANG_MS;
+    bool loud_seen_ = false;
+    std::chrono::steady_clock::time_point last_loud_time_{};
+};
 PaDeviceIndex findDeviceByName(const std::string& name, const audio::portaudio::PortAudioInterface& pa);
 
 // Calculates the initial read position from a previous timestamp
@@ -33,6 +99,110 @@ PaDeviceIndex findDeviceByName(const std::string& name, const audio::portaudio::
 // Returns the write position if previous_timestamp == 0 (default: most recent audio)
 uint64_t get_initial_read_position(const std::shared_ptr<audio::InputStreamContext>& stream_context, int64_t previous_timestamp);
 
+// How many device samples to read for one delivery while a session is
+// catching up on historical audio. Coalesces the backlog into whole multiples
+// of device_samples_per_chunk (preserving MP3 frame alignment), bounded by
+// max_chunk_bytes of output data - scaled through the resampling ratio when
+// the device and requested rates differ - and by the samples actually
+// available. Never returns less than one chunk.
+int calculate_catchup_read_size(uint64_t available_samples,
+                                int device_samples_per_chunk,
+                                int stream_sample_rate,
+                                int requested_sample_rate,
+                                int bytes_per_output_sample,
+                                int max_chunk_bytes);
+
+// Lock-free runtime counters behind the stats do_command. All fields are
+// relaxed atomics bumped on the streaming paths; reads are point-in-time
+// snapshots. Totals plus counts rather than averages, so fleet monitoring can
+// compute rates and deltas between scrapes.
+struct MicrophoneStats {
+    std::atomic<uint64_t> encode_ns_total{0};
+    std::atomic<uint64_t> encode_chunks{0};
+    std::atomic<uint64_t> resample_ns_total{0};
+    std::atomic<uint64_t> resample_chunks{0};
+    // Time spent inside the chunk handler (the client delivery path)
+    std::atomic<uint64_t> delivery_ns_total{0};
+    std::atomic<uint64_t> delivered_chunks{0};
+    std::atomic<uint64_t> restarts{0};
+};
+
+// One frame-aligned encoded MP3 chunk produced by SharedMP3Encoder.
+// Positions are capture-ring sample positions (device rate, all channels),
+// already adjusted for the LAME encoder delay.
+struct EncodedMP3Chunk {
+    uint64_t sequence = 0;
+    uint64_t start_position = 0;
+    uint64_t end_position = 0;
+    // RMS level of the source PCM, for per-session silence gating
+    double rms = 0.0;
+    std::vector<uint8_t> data;
+};
+
+// Shared per-microphone MP3 encoding stage.
+// One LAME instance encodes the capture stream once into a small ring of
+// recent encoded chunks; each live mp3 get_audio session reads from the ring
+// at its own cursor, mirroring how InputStreamContext decouples PCM readers
+// by position. This keeps MP3 CPU cost O(1) in the number of clients.
+// Encoding is demand-driven: the first session that needs a chunk produces
+// it (serialized by encode_mu_), later sessions get the cached copy.
+class SharedMP3Encoder {
+   public:
+    // stats may be null (tests); when set, encode and resample timings are
+    // recorded into it
+    SharedMP3Encoder(std::shared_ptr<audio::InputStreamContext> stream_context,
+                     int device_sample_rate,
+                     int sample_rate,
+                     int num_channels,
+                     MicrophoneStats* stats = nullptr);
+
+    const std::shared_ptr<audio::InputStreamContext>& stream_context() const { return stream_context_; }
+    int sample_rate() const { return sample_rate_; }
+    int num_channels() const { return num_channels_; }
+
+    // Sequence number the next encoded chunk will receive. New sessions start
+    // reading here (live audio).
+    uint64_t next_sequence();
+
+    // Copies the chunk with the given sequence into `out`, producing it from
+    // the capture ring if it has not been encoded yet. If the requested chunk
+    // has already been evicted, skips forward to the oldest retained chunk and
+    // updates `sequence` - same contract as falling behind the PCM ring.
+    // Returns false if no chunk became available before the timeout (e.g. the
+    // capture stream has stalled).
+    bool get_chunk(uint64_t& sequence, EncodedMP3Chunk& out, std::chrono::milliseconds timeout);
+
+   private:
+    // Encodes the next chunk and publishes it to the ring. Caller must hold
+    // encode_mu_. Returns false if a full chunk of PCM did not arrive before
+    // the deadline.
+    bool produce_next_chunk(std::chrono::steady_clock::time_point deadline);
+
+    std::shared_ptr<audio::InputStreamContext> stream_context_;
+    int sample_rate_;
+    int num_channels_;
+    int device_samples_per_chunk_;
+    MicrophoneStats* stats_;
+    MP3EncoderContext ctx_;
+    std::unique_ptr<audio::Resampler> resampler_;
+    uint64_t encode_read_position_;
+    // Scratch buffers reused across chunks so steady-state encoding does not allocate
+    std::vector<int16_t> pcm_buffer_;
+    std::vector<int16_t> resampled_buffer_;
+
+    // Serializes chunk production (LAME state is sequential)
+    std::mutex encode_mu_;
+    // Guards the chunk ring and sequence counter
+    std::mutex ring_mu_;
+    std::condition_variable chunk_cv_;
+    std::deque<EncodedMP3Chunk> ring_;
+    uint64_t next_sequence_ = 0;
+
+    // ~5 seconds of history at the default 150ms chunk target - enough slack
+    // for a slow client without holding encoded audio indefinitely
+    static constexpr size_t MAX_RING_CHUNKS = 32;
+};
+
 class Microphone final : public viam::sdk::AudioIn, public viam::sdk::Reconfigurable {
    public:
     Microphone(viam::sdk::Dependencies deps, viam::sdk::ResourceConfig cfg, audio::portaudio::PortAudioInterface* pa = nullptr);
@@ -49,6 +219,54 @@ class Microphone final : public viam::sdk::AudioIn, public viam::sdk::Reconfigur
                    int64_t const& previous_timestamp,
                    const viam::sdk::ProtoStruct& extra);
 
+    // The streaming loop behind get_audio, instantiated once per codec so
+    // the per-chunk path carries no runtime codec dispatch: the PCM
+    // instantiations are straight-line read/convert with the MP3 branches
+    // compiled away. Defined in microphone.cpp.
+    template <audio::codec::AudioCodec Codec>
+    void stream_chunks(std::string const& codec,
+                       std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
+                       double const& duration_seconds,
+                       int64_t const& previous_timestamp,
+                       std::shared_ptr<audio::InputStreamContext> stream_context,
+                       uint64_t read_position,
+                       SilenceGate gate);
+
+    // The streaming loop for mp3 sessions with a private encoder
+    // (previous_timestamp resume). Runs as a two-stage pipeline: the session
+    // thread reads chunks from the capture ring into a small bounded queue,
+    // and an encoder thread drains it, so ring-read cadence is isolated from
+    // LAME encode jitter and the stages overlap on multicore devices.
+    void stream_mp3_chunks_pipelined(std::string const& codec,
+                                     std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
+                                     double const& duration_seconds,
+                                     int64_t const& previous_timestamp,
+                                     std::shared_ptr<audio::InputStreamContext> stream_context,
+                                     uint64_t read_position,
+                                     SilenceGate gate);
+
+    // The streaming loop for live mp3 sessions: reads encoded chunks from the
+    // shared encoder ring at the session's own cursor instead of running a
+    // private LAME instance per client
+    void stream_shared_mp3_chunks(std::string const& codec,
+                                  std::function<bool(vsdk::AudioIn::audio_chunk&& chunk)> const& chunk_handler,
+                                  double const& duration_seconds,
+                                  std::shared_ptr<audio::InputStreamContext> stream_context,
+                                  SilenceGate gate);
+
+    // Returns the shared encoder for the given capture context, creating or
+    // replacing it if the context or audio format changed
+    std::shared_ptr<SharedMP3Encoder> acquire_shared_mp3_encoder(const std::shared_ptr<audio::InputStreamContext>& stream_context);
+
+    // Staleness and xrun logging shared by the get_audio streaming loops,
+    // run whenever a loop has no chunk ready. Stall recovery itself is owned
+    // by the module's StreamSupervisor thread, not the read loops.
+    void check_stream_health(const std::shared_ptr<audio::InputStreamContext>& stream_context,
+                             PaStream* current_stream,
+                             uint64_t& last_staleness_log_ns,
+                             uint64_t& last_logged_overflow_count,
+                             uint64_t& last_logged_underflow_count);
+
     viam::sdk::audio_properties get_properties(const viam::sdk::ProtoStruct& extra);
     std::vector<viam::sdk::GeometryConfig> get_geometries(const viam::sdk::ProtoStruct& extra);
     void reconfigure(const viam::sdk::Dependencies& deps, const viam::sdk::ResourceConfig& cfg);
@@ -57,13 +275,26 @@ class Microphone final : public viam::sdk::AudioIn, public viam::sdk::Reconfigur
     // Must NOT be called while holding stream_ctx_mu_.
     void restart_stalled_stream(const std::shared_ptr<audio::InputStreamContext>& stream_context);
 
+    // Allocates (and zeroes) the spare capture context for the current stream
+    // parameters so a later stall restart is a pointer swap instead of a
+    // multi-second ring allocation. Caller must hold stream_ctx_mu_.
+    void prewarm_standby_context_locked();
+
+    // Returns the pre-restart context retained by the last stall restart if
+    // it is still within its retention window and previous_timestamp predates
+    // the live context; null otherwise. Lets timestamp-based reads spanning a
+    // restart replay the frozen history the old ring still holds.
+    std::shared_ptr<audio::InputStreamContext> retired_context_covering(int64_t previous_timestamp);
+
     void setup_stream_params(audio::codec::AudioCodec codec_enum,
                              MP3EncoderContext& mp3_ctx,
+                             OpusEncoderContext& opus_ctx,
                              bool is_reconfigure,
                              int& stream_sample_rate,
                              int& requested_sample_rate,
                              int& stream_num_channels,
                              int& stream_historical_throttle_ms,
+                             int& stream_catchup_max_chunk_bytes,
                              int& samples_per_chunk,
                              int& device_samples_per_chunk);
 
@@ -71,19 +302,59 @@ class Microphone final : public viam::sdk::AudioIn, public viam::sdk::Reconfigur
     int requested_sample_rate_;  // User's requested sample rate (may differ from device rate)
     double latency_;
     int historical_throttle_ms_;  // Throttle time for historical data stream
+    // Output-byte cap per coalesced chunk during historical catch-up
+    // (0 disables coalescing)
+    int catchup_max_chunk_bytes_;
+    // Silence suppression gate settings (opt-in; overridable per call via extra)
+    bool silence_suppression_;
+    double silence_threshold_rms_;
+    int silence_hang_ms_;
+    // Opus session settings (bitrate in bps, complexity 0-10)
+    int opus_bitrate_;
+    int opus_complexity_;
+    // Seconds of replayable capture history the ring holds
+    int buffer_duration_seconds_;
     static vsdk::Model model;
 
-    // The mutex protects the stream, context, and the active streams counter
+    // The mutex protects the stream handle, stream/config parameters, and the
+    // restart counter. It is only taken on the reconfigure/restart path - the
+    // streaming loops stay off it in steady state.
     std::mutex stream_ctx_mu_;
     PaStream* stream_;
+    // Active capture context, published with std::atomic_store and read with
+    // std::atomic_load so the per-iteration context-change check in the
+    // streaming loops is a single atomic load rather than a mutex acquisition
     std::shared_ptr<audio::InputStreamContext> audio_context_;
     // This is null in production and used for testing to inject the mock portaudio functions
     const audio::portaudio::PortAudioInterface* pa_;
     // Count of active get_audio calls
-    int active_streams_;
+    std::atomic<int> active_streams_;
+    // Runtime counters surfaced by do_command({"stats": true})
+    MicrophoneStats stats_;
     int restart_attempts_;
+    // Shared encode stage for live mp3 sessions, rebuilt when the capture
+    // context or audio format changes. Guarded by stream_ctx_mu_.
+    std::shared_ptr<SharedMP3Encoder> shared_mp3_encoder_;
+    // Pre-allocated spare capture context kept warm for stall restarts - the
+    // ring allocation and zeroing happen off the restart path, at the cost of
+    // one extra ring's worth of memory. Guarded by stream_ctx_mu_.
+    std::shared_ptr<audio::InputStreamContext> standby_context_;
+    // Previous capture context retained after a stall restart so historical
+    // sessions can still replay its frozen ring. Dropped after the
+    // ring-history duration, on reconfigure, or at the next restart.
+    // Guarded by stream_ctx_mu_.
+    std::shared_ptr<audio::InputStreamContext> retired_context_;
+    std::chrono::steady_clock::time_point retired_at_{};
 
     audio::utils::StreamParams stream_params_;
+    // Parsed attributes behind the current stream, retained so reconfigure
+    // can diff a pushed config against them and skip the stream teardown when
+    // only stream-irrelevant attributes changed. Guarded by stream_ctx_mu_.
+    audio::utils::ConfigParams config_params_;
+
+    // Registration with the module-wide stream supervisor, which owns stall
+    // detection and restart for this capture stream
+    audio::supervision::StreamSupervisor::WatchId supervisor_watch_ = 0;
 };
 
 /**
@@ -24,9 +24,9 @@ MP3DecoderContext::~MP3DecoderContext() {
 }
 
 // helper to skip id3 tag: https://id3.org/id3v2.3.0
-static size_t get_id3v2_offset(const std::vector<uint8_t>& data) {
+static size_t get_id3v2_offset(const uint8_t* data, const size_t size) {
     // For safety: id3 header is 10 bytes
-    if (data.size() < 10) {
+    if (size < 10) {
         return 0;
     }
 
@@ -42,12 +42,84 @@ static size_t get_id3v2_offset(const std::vector<uint8_t>& data) {
     return 0;
 }
 
-// Helper to append PCM samples to output buffer
-static void append_samples(std::vector<uint8_t>& output_data,
-                           const std::vector<int16_t>& pcm_samples_left,
-                           const std::vector<int16_t>& pcm_samples_right,
-                           const int sample_count,
-                           const int num_channels) {
+// Layer III bitrate tables in kbps, indexed by the frame header's bitrate
+// field. Index 0 is "free format" and 15 is invalid - both yield 0.
+static const int MPEG1_LAYER3_BITRATES_KBPS[16] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0};
+static const int MPEG2_LAYER3_BITRATES_KBPS[16] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0};
+
+size_t estimate_mp3_decoded_bytes(const uint8_t* encoded_data, const size_t encoded_size) {
+    if (encoded_data == nullptr || encoded_size < 4) {
+        return 0;
+    }
+
+    // Skip the ID3v2 tag and scan to the first frame sync, as the decoder does
+    size_t offset = get_id3v2_offset(encoded_data, encoded_size);
+    while (offset + 4 <= encoded_size) {
+        if (encoded_data[offset] == 0xFF && (encoded_data[offset + 1] & 0xE0) == 0xE0) {
+            break;
+        }
+        offset++;
+    }
+    if (offset + 4 > encoded_size) {
+        return 0;
+    }
+
+    const uint8_t* header = encoded_data + offset;
+    const int version_bits = (header[1] >> 3) & 0x3;  // 3 = MPEG1, 2 = MPEG2, 0 = MPEG2.5
+    const int layer_bits = (header[1] >> 1) & 0x3;    // 1 = Layer III
+    const int bitrate_index = (header[2] >> 4) & 0xF;
+    const int samplerate_index = (header[2] >> 2) & 0x3;
+    const int channel_mode = (header[3] >> 6) & 0x3;  // 3 = mono
+    if (version_bits == 1 || layer_bits != 1 || samplerate_index == 3) {
+        return 0;
+    }
+
+    const bool is_mpeg1 = version_bits == 3;
+    static const int MPEG1_SAMPLE_RATES[3] = {44100, 48000, 32000};
+    int sample_rate = MPEG1_SAMPLE_RATES[samplerate_index];
+    if (version_bits == 2) {
+        sample_rate /= 2;  // MPEG2
+    } else if (version_bits == 0) {
+        sample_rate /= 4;  // MPEG2.5
+    }
+    const int num_channels = channel_mode == 3 ? 1 : 2;
+    const size_t samples_per_frame = is_mpeg1 ? 1152 : 576;
+    const size_t bytes_per_frame_out = samples_per_frame * num_channels * sizeof(int16_t);
+
+    // Xing/Info tag: VBR (and many CBR) encoders write the total frame count
+    // into the first frame, right after the side info - exact when present
+    const size_t side_info_size = is_mpeg1 ? (num_channels == 1 ? 17 : 32) : (num_channels == 1 ? 9 : 17);
+    const size_t tag_offset = offset + 4 + side_info_size;
+    if (tag_offset + 12 <= encoded_size) {
+        const uint8_t* tag = encoded_data + tag_offset;
+        const bool has_tag = (memcmp(tag, "Xing", 4) == 0 || memcmp(tag, "Info", 4) == 0);
+        if (has_tag) {
+            const uint32_t flags = (tag[4] << 24) | (tag[5] << 16) | (tag[6] << 8) | tag[7];
+            if (flags & 0x1) {  // frames field present
+                const uint32_t frame_count = (tag[8] << 24) | (tag[9] << 16) | (tag[10] << 8) | tag[11];
+                return static_cast<size_t>(frame_count) * bytes_per_frame_out;
+            }
+        }
+    }
+
+    // No frame count - derive the duration from the header bitrate. Exact
+    // for CBR; for untagged VBR the first frame's rate is still a usable
+    // reserve hint.
+    const int bitrate_kbps = is_mpeg1 ? MPEG1_LAYER3_BITRATES_KBPS[bitrate_index] : MPEG2_LAYER3_BITRATES_KBPS[bitrate_index];
+    if (bitrate_kbps <= 0) {
+        return 0;
+    }
+    const double duration_seconds = static_cast<double>(encoded_size - offset) * 8.0 / (bitrate_kbps * 1000.0);
+    const size_t estimated_frames = static_cast<size_t>(duration_seconds * sample_rate / samples_per_frame) + 1;
+    return estimated_frames * bytes_per_frame_out;
+}
+
+// Helper to interleave one decoded frame into the reusable frame buffer
+static void interleave_frame(std::vector<int16_t>& interleaved,
+                             const std::vector<int16_t>& pcm_samples_left,
+                             const std::vector<int16_t>& pcm_samples_right,
+                             const int sample_count,
+                             const int num_channels) {
     if (num_channels != 1 && num_channels != 2) {
         VIAM_SDK_LOG(error) << "invalid num channels: " << num_channels;
         throw std::invalid_argument("invalid num channels");
@@ -62,11 +134,9 @@ static void append_samples(std::vector<uint8_t>& output_data,
                             << ", right sample size =" << pcm_samples_right.size() << ")";
         throw std::runtime_error("sample_count exceeds pcm data buffer size");
     }
-    const size_t samples_to_add = sample_count * num_channels;
-
-    // Interleave into a int16_t buffer
-    std::vector<int16_t> interleaved;
-    interleaved.reserve(samples_to_add);
+    // Interleave into the caller's reusable buffer - capacity persists
+    // across frames, so steady-state decoding does not allocate
+    interleaved.clear();
 
     if (num_channels == 1) {
         // mono: copy left channel samples
@@ -78,50 +148,58 @@ static void append_samples(std::vector<uint8_t>& output_data,
             interleaved.push_back(pcm_samples_right[i]);
         }
     }
-
-    // Append the raw bytes of interleaved samples to output_data
-    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(interleaved.data());
-    output_data.insert(output_data.end(), bytes, bytes + interleaved.size() * sizeof(int16_t));
 }
 
-void decode_mp3_to_pcm16(MP3DecoderContext& ctx, const std::vector<uint8_t>& encoded_data, std::vector<uint8_t>& decoded_data) {
+int decode_mp3_streaming(MP3DecoderContext& ctx,
+                         const uint8_t* encoded_data,
+                         const size_t encoded_size,
+                         const std::function<bool(const int16_t* samples, int sample_count)>& on_frame) {
     if (!ctx.decoder) {
         VIAM_SDK_LOG(error) << "decode_mp3_to_pcm16: MP3 decoder not initialized";
         throw std::runtime_error("decode_mp3_to_pcm16: MP3 decoder not initialized");
     }
 
-    if (encoded_data.empty()) {
+    if (encoded_size == 0) {
         VIAM_SDK_LOG(debug) << "decode_mp3_to_pcm16: no data to decode";
-        return;
+        return 0;
     }
 
     // Skip ID3v2 tag if present
-    size_t offset = get_id3v2_offset(encoded_data);
+    size_t offset = get_id3v2_offset(encoded_data, encoded_size);
     if (offset > 0) {
         VIAM_SDK_LOG(debug) << "Skipped ID3v2 tag of size " << offset << " bytes";
     }
 
     // Scan for first MP3 frame sync (0xFF followed by 0xE0 mask)
-    while (offset + 1 < encoded_data.size()) {
+    while (offset + 1 < encoded_size) {
         if (encoded_data[offset] == 0xFF && (encoded_data[offset + 1] & 0xE0) == 0xE0) {
             break;
         }
         offset++;
     }
 
-    if (offset >= encoded_data.size()) {
+    if (offset >= encoded_size) {
         VIAM_SDK_LOG(error) << "decode_mp3_to_pcm16: No MP3 frame sync found";
         throw std::runtime_error("decode_mp3_to_pcm16: MP3 decoder: no valid frame found");
     }
 
-    const size_t mp3_data_size = encoded_data.size() - offset;
+    const size_t mp3_data_size = encoded_size - offset;
 
     VIAM_SDK_LOG(debug) << "Decoding MP3 data, buffer size after sync scan: " << mp3_data_size << " (skipped " << offset << " bytes total)";
 
-    // Buffers for decoded PCM samples - one MP3 frame is max 1152 samples
+    // Per-frame scratch lives on the context - one MP3 frame is max 1152
+    // samples per channel, so these size once on the context's first decode
+    // and every later call (and every later play) reuses the allocations
     const size_t frame_buffer_size = 1152;  // Samples per channel
-    std::vector<int16_t> pcm_left(frame_buffer_size);
-    std::vector<int16_t> pcm_right(frame_buffer_size);
+    std::vector<int16_t>& pcm_left = ctx.pcm_left;
+    std::vector<int16_t>& pcm_right = ctx.pcm_right;
+    pcm_left.resize(frame_buffer_size);
+    pcm_right.resize(frame_buffer_size);
+
+    // Reusable interleaved frame buffer handed to on_frame - reserved once,
+    // refilled per frame, never reallocated in steady state
+    std::vector<int16_t>& interleaved = ctx.interleaved;
+    interleaved.reserve(frame_buffer_size * 2);
 
     mp3data_struct mp3data;
     memset(&mp3data, 0, sizeof(mp3data));
@@ -131,7 +209,7 @@ void decode_mp3_to_pcm16(MP3DecoderContext& ctx, const std::vector<uint8_t>& enc
     // Feed ALL data to LAME once - it buffers internally
     // First call may return 0
     int decoded_samples = hip_decode1_headers(ctx.decoder.get(),
-                                              const_cast<unsigned char*>(encoded_data.data() + offset),
+                                              const_cast<unsigned char*>(encoded_data + offset),
                                               mp3_data_size,
                                               pcm_left.data(),
                                               pcm_right.data(),
@@ -149,10 +227,13 @@ void decode_mp3_to_pcm16(MP3DecoderContext& ctx, const std::vector<uint8_t>& enc
         VIAM_SDK_LOG(debug) << "found MP3 audio properties: " << ctx.sample_rate << "Hz, " << ctx.num_channels << " channels";
     }
 
-    // Append first frame if we got samples
+    // Deliver first frame if we got samples
     if (decoded_samples > 0) {
-        append_samples(decoded_data, pcm_left, pcm_right, decoded_samples, ctx.num_channels);
+        interleave_frame(interleaved, pcm_left, pcm_right, decoded_samples, ctx.num_channels);
         frames_decoded++;
+        if (!on_frame(interleaved.data(), static_cast<int>(interleaved.size()))) {
+            return frames_decoded;
+        }
     }
 
     // extract all remaining frames by calling with null
@@ -182,8 +263,11 @@ void decode_mp3_to_pcm16(MP3DecoderContext& ctx, const std::vector<uint8_t>& enc
             ctx.num_channels = mp3data.stereo;
             VIAM_SDK_LOG(debug) << "found MP3 audio properties: " << ctx.sample_rate << "Hz, " << ctx.num_channels << " channels";
         }
-        append_samples(decoded_data, pcm_left, pcm_right, decoded_samples, ctx.num_channels);
+        interleave_frame(interleaved, pcm_left, pcm_right, decoded_samples, ctx.num_channels);
         frames_decoded++;
+        if (!on_frame(interleaved.data(), static_cast<int>(interleaved.size()))) {
+            return frames_decoded;
+        }
     }
 
     // Ensure we extracted valid audio properties
@@ -198,8 +282,29 @@ void decode_mp3_to_pcm16(MP3DecoderContext& ctx, const std::vector<uint8_t>& enc
         throw std::runtime_error("[decode_mp3_to_pcm16]: decoded 0 frames");
     }
 
-    VIAM_SDK_LOG(debug) << "[decode_mp3_to_pcm16]: Total decoded: " << (decoded_data.size() / sizeof(int16_t) / ctx.num_channels)
-                        << " frames (" << decoded_data.size() << " bytes)";
+    return frames_decoded;
+}
+
+void decode_mp3_to_pcm16(MP3DecoderContext& ctx, const std::vector<uint8_t>& encoded_data, std::vector<uint8_t>& decoded_data) {
+    // Reserve the whole output up front from the stream headers (plus one
+    // frame of slack for estimate rounding) - a 30s stereo clip is megabytes
+    // of PCM that would otherwise be built through repeated reallocations,
+    // each memmoving everything decoded so far
+    const size_t estimated_bytes = estimate_mp3_decoded_bytes(encoded_data.data(), encoded_data.size());
+    if (estimated_bytes > 0) {
+        decoded_data.reserve(decoded_data.size() + estimated_bytes + 1152 * 2 * sizeof(int16_t));
+    }
+
+    decode_mp3_streaming(ctx, encoded_data, [&decoded_data](const int16_t* samples, int sample_count) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(samples);
+        decoded_data.insert(decoded_data.end(), bytes, bytes + static_cast<size_t>(sample_count) * sizeof(int16_t));
+        return true;
+    });
+
+    if (ctx.num_channels > 0) {
+        VIAM_SDK_LOG(debug) << "[decode_mp3_to_pcm16]: Total decoded: " << (decoded_data.size() / sizeof(int16_t) / ctx.num_channels)
+                            << " frames (" << decoded_data.size() << " bytes)";
+    }
 }
 
 }  // namespace speaker
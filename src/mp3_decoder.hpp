@@ -2,6 +2,7 @@
 
 #include <lame/lame.h>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 #include "audio_utils.hpp"
@@ -16,11 +17,44 @@ struct MP3DecoderContext {
     int sample_rate = 0;
     int num_channels = 0;
 
+    // Per-frame decode scratch, owned by the context and reused across
+    // decode calls so repeated plays do not re-allocate it. Sized on first
+    // use in decode_mp3_streaming.
+    std::vector<int16_t> pcm_left;
+    std::vector<int16_t> pcm_right;
+    std::vector<int16_t> interleaved;
+
     MP3DecoderContext();
 
     ~MP3DecoderContext();
 };
 
+// Estimates the decoded pcm16 output size in bytes from the stream's first
+// frame header: exact when a Xing/Info tag carries the frame count (VBR
+// encoders write one), otherwise duration derived from the header bitrate
+// (exact for CBR, approximate for untagged VBR). Returns 0 when no parseable
+// frame header is found. Used to reserve the output vector once instead of
+// growing it geometrically through the decode.
+size_t estimate_mp3_decoded_bytes(const uint8_t* encoded_data, size_t encoded_size);
+
+// Decodes MP3 frame by frame, invoking on_frame with each frame's samples
+// interleaved into a reusable buffer (sample_count is the total interleaved
+// count, i.e. frames * channels). The buffer is only valid for the duration of
+// the call, so on_frame must consume it before returning; returning false
+// stops decoding early. ctx.sample_rate and ctx.num_channels are populated
+// before the first invocation. Returns the number of frames decoded.
+int decode_mp3_streaming(MP3DecoderContext& ctx,
+                         const uint8_t* encoded_data,
+                         size_t encoded_size,
+                         const std::function<bool(const int16_t* samples, int sample_count)>& on_frame);
+
+inline int decode_mp3_streaming(MP3DecoderContext& ctx,
+                                const std::vector<uint8_t>& encoded_data,
+                                const std::function<bool(const int16_t* samples, int sample_count)>& on_frame) {
+    return decode_mp3_streaming(ctx, encoded_data.data(), encoded_data.size(), on_frame);
+}
+
+// Decodes the entire MP3 payload into output_data as interleaved pcm16 bytes
 void decode_mp3_to_pcm16(MP3DecoderContext& ctx, const std::vector<uint8_t>& encoded_data, std::vector<uint8_t>& output_data);
 
 }  // namespace speaker
@@ -0,0 +1,81 @@
+#include "opus_decoder.hpp"
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include "opus_encoder.hpp"
+
+namespace speaker {
+
+void decode_opus_to_pcm16(OpusDecoderContext& ctx,
+                          const std::vector<uint8_t>& encoded_data,
+                          const int sample_rate,
+                          const int num_channels,
+                          std::vector<uint8_t>& output_data) {
+    if (encoded_data.empty()) {
+        VIAM_SDK_LOG(debug) << "decode_opus_to_pcm16: no data to decode";
+        return;
+    }
+
+    if (!microphone::is_opus_supported_sample_rate(sample_rate)) {
+        std::ostringstream buffer;
+        buffer << "Opus only supports sample rates of 8000, 12000, 16000, 24000, or 48000 Hz, got " << sample_rate << " Hz";
+        VIAM_SDK_LOG(error) << buffer.str();
+        throw std::invalid_argument(buffer.str());
+    }
+    if (num_channels != 1 && num_channels != 2) {
+        std::ostringstream buffer;
+        buffer << "Opus supports 1 or 2 channels, got " << num_channels;
+        VIAM_SDK_LOG(error) << buffer.str();
+        throw std::invalid_argument(buffer.str());
+    }
+
+    if (!ctx.decoder || ctx.sample_rate != sample_rate || ctx.num_channels != num_channels) {
+        int err = OPUS_OK;
+        CleanupPtr<opus_decoder_destroy> decoder(opus_decoder_create(sample_rate, num_channels, &err));
+        if (!decoder || err != OPUS_OK) {
+            VIAM_SDK_LOG(error) << "Failed to initialize Opus decoder: " << opus_strerror(err);
+            throw std::runtime_error("Failed to initialize Opus decoder");
+        }
+        ctx.decoder = std::move(decoder);
+        ctx.sample_rate = sample_rate;
+        ctx.num_channels = num_channels;
+    }
+
+    // Reused frame scratch sized for the longest frame the codec allows
+    const int max_frame_samples = sample_rate * OPUS_MAX_FRAME_MS / 1000;
+    std::vector<int16_t> frame_buffer(static_cast<size_t>(max_frame_samples) * num_channels);
+
+    size_t pos = 0;
+    int packets_decoded = 0;
+    while (pos < encoded_data.size()) {
+        if (pos + 2 > encoded_data.size()) {
+            VIAM_SDK_LOG(error) << "decode_opus_to_pcm16: truncated packet length prefix at byte " << pos;
+            throw std::invalid_argument("malformed Opus packet framing: truncated length prefix");
+        }
+        const size_t packet_size = encoded_data[pos] | (static_cast<size_t>(encoded_data[pos + 1]) << 8);
+        pos += 2;
+        if (packet_size == 0 || pos + packet_size > encoded_data.size()) {
+            VIAM_SDK_LOG(error) << "decode_opus_to_pcm16: invalid packet size " << packet_size << " at byte " << pos;
+            throw std::invalid_argument("malformed Opus packet framing: invalid packet size");
+        }
+
+        const int frame_samples =
+            opus_decode(ctx.decoder.get(), encoded_data.data() + pos, static_cast<opus_int32>(packet_size), frame_buffer.data(),
+                        max_frame_samples, 0);
+        if (frame_samples < 0) {
+            VIAM_SDK_LOG(error) << "Opus decoding failed: " << opus_strerror(frame_samples);
+            throw std::runtime_error("Opus decoding failed");
+        }
+        pos += packet_size;
+        packets_decoded++;
+
+        const size_t frame_bytes = static_cast<size_t>(frame_samples) * num_channels * sizeof(int16_t);
+        const size_t current_size = output_data.size();
+        output_data.resize(current_size + frame_bytes);
+        std::memcpy(output_data.data() + current_size, frame_buffer.data(), frame_bytes);
+    }
+
+    VIAM_SDK_LOG(debug) << "Opus decoding complete: " << packets_decoded << " packets, " << output_data.size() << " bytes of pcm16";
+}
+
+}  // namespace speaker
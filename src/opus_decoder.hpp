@@ -0,0 +1,35 @@
+#pragma once
+
+#include <opus/opus.h>
+
+#include <cstdint>
+#include <vector>
+#include "audio_utils.hpp"
+
+namespace speaker {
+
+using audio::utils::CleanupPtr;
+
+// Longest frame Opus allows is 120ms
+constexpr int OPUS_MAX_FRAME_MS = 120;
+
+struct OpusDecoderContext {
+    CleanupPtr<opus_decoder_destroy> decoder = nullptr;
+
+    int sample_rate = 0;
+    int num_channels = 0;
+};
+
+// Decodes a stream of length-prefixed Opus packets ([uint16 LE packet
+// length][packet bytes], as produced by encode_samples_to_opus) into
+// output_data as interleaved pcm16 bytes. Opus packets do not carry their
+// sample rate, so the caller supplies the rate and channel count from the
+// chunk's audio_info. Throws std::invalid_argument on malformed framing or an
+// unsupported rate, std::runtime_error on decoder failures.
+void decode_opus_to_pcm16(OpusDecoderContext& ctx,
+                          const std::vector<uint8_t>& encoded_data,
+                          int sample_rate,
+                          int num_channels,
+                          std::vector<uint8_t>& output_data);
+
+}  // namespace speaker
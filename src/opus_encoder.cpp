@@ -0,0 +1,108 @@
+#include "opus_encoder.hpp"
+#include <sstream>
+#include <stdexcept>
+
+namespace microphone {
+
+bool is_opus_supported_sample_rate(const int sample_rate) {
+    for (const int rate : OPUS_SUPPORTED_SAMPLE_RATES) {
+        if (sample_rate == rate) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void initialize_opus_encoder(OpusEncoderContext& ctx, const int sample_rate, const int num_channels, const int bitrate, const int complexity) {
+    if (!is_opus_supported_sample_rate(sample_rate)) {
+        std::ostringstream buffer;
+        buffer << "Opus only supports sample rates of 8000, 12000, 16000, 24000, or 48000 Hz, got " << sample_rate
+               << " Hz. Configure sample_rate to an Opus rate to use this codec.";
+        VIAM_SDK_LOG(error) << buffer.str();
+        throw std::invalid_argument(buffer.str());
+    }
+    if (num_channels != 1 && num_channels != 2) {
+        std::ostringstream buffer;
+        buffer << "Opus supports 1 or 2 channels, got " << num_channels;
+        VIAM_SDK_LOG(error) << buffer.str();
+        throw std::invalid_argument(buffer.str());
+    }
+
+    ctx.sample_rate = sample_rate;
+    ctx.num_channels = num_channels;
+    ctx.bitrate = bitrate;
+    ctx.complexity = complexity;
+
+    int err = OPUS_OK;
+    CleanupPtr<opus_encoder_destroy> encoder(opus_encoder_create(sample_rate, num_channels, OPUS_APPLICATION_AUDIO, &err));
+    if (!encoder || err != OPUS_OK) {
+        VIAM_SDK_LOG(error) << "Failed to initialize Opus encoder: " << opus_strerror(err);
+        throw std::runtime_error("Failed to initialize Opus encoder");
+    }
+    ctx.encoder = std::move(encoder);
+
+    opus_encoder_ctl(ctx.encoder.get(), OPUS_SET_BITRATE(bitrate));
+    opus_encoder_ctl(ctx.encoder.get(), OPUS_SET_COMPLEXITY(complexity));
+
+    opus_int32 lookahead = 0;
+    opus_encoder_ctl(ctx.encoder.get(), OPUS_GET_LOOKAHEAD(&lookahead));
+    ctx.encoder_delay = lookahead;
+
+    ctx.frame_size = sample_rate * OPUS_FRAME_MS / 1000;
+    ctx.packet_buffer.resize(OPUS_MAX_PACKET_BYTES);
+
+    VIAM_SDK_LOG(debug) << "Opus encoder initialized: " << sample_rate << "Hz, " << num_channels << " channels, " << bitrate
+                        << "bps, complexity " << complexity << ", encoder delay: " << ctx.encoder_delay
+                        << " samples, frame size: " << ctx.frame_size << " samples/frame";
+}
+
+void encode_samples_to_opus(
+    OpusEncoderContext& ctx, int16_t* samples, const int sample_count, uint64_t chunk_start_position, std::vector<uint8_t>& output_data) {
+    if (!ctx.encoder) {
+        VIAM_SDK_LOG(error) << "encode_samples_to_opus: Opus encoder not initialized";
+        throw std::runtime_error("encode_samples_to_opus: Opus encoder not initialized");
+    }
+
+    if (samples == nullptr) {
+        VIAM_SDK_LOG(error) << "encode_samples_to_opus: samples pointer is null";
+        throw std::invalid_argument("encode_samples_to_opus: samples cannot be null");
+    }
+
+    if (sample_count <= 0) {
+        VIAM_SDK_LOG(debug) << "encode_samples_to_opus: no samples to encode (count=" << sample_count << ")";
+        return;
+    }
+
+    const int samples_per_frame = ctx.frame_size * ctx.num_channels;
+    if (sample_count % samples_per_frame != 0) {
+        std::ostringstream buffer;
+        buffer << "encode_samples_to_opus: sample_count " << sample_count << " is not a multiple of the Opus frame size ("
+               << samples_per_frame << " interleaved samples)";
+        VIAM_SDK_LOG(error) << buffer.str();
+        throw std::invalid_argument(buffer.str());
+    }
+
+    for (int offset = 0; offset < sample_count; offset += samples_per_frame) {
+        const opus_int32 packet_bytes = opus_encode(ctx.encoder.get(), samples + offset, ctx.frame_size, ctx.packet_buffer.data(),
+                                                    static_cast<opus_int32>(ctx.packet_buffer.size()));
+        if (packet_bytes < 0) {
+            VIAM_SDK_LOG(error) << "Opus encoding failed: " << opus_strerror(packet_bytes);
+            throw std::runtime_error("Opus encoding failed");
+        }
+
+        // Length-prefix each packet - see the framing note in the header
+        output_data.push_back(static_cast<uint8_t>(packet_bytes & 0xFF));
+        output_data.push_back(static_cast<uint8_t>((packet_bytes >> 8) & 0xFF));
+        output_data.insert(output_data.end(), ctx.packet_buffer.begin(), ctx.packet_buffer.begin() + packet_bytes);
+    }
+}
+
+void cleanup_opus_encoder(OpusEncoderContext& ctx) {
+    ctx.encoder = nullptr;
+    ctx.sample_rate = 0;
+    ctx.num_channels = 0;
+    ctx.encoder_delay = 0;
+    ctx.frame_size = 0;
+}
+
+}  // namespace microphone
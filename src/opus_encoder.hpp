@@ -0,0 +1,63 @@
+#pragma once
+
+#include <opus/opus.h>
+
+#include <cstdint>
+#include <vector>
+#include "audio_utils.hpp"
+
+namespace microphone {
+
+// 24 kbps - Opus at this rate gives better perceived voice quality than much
+// higher MP3 bitrates, which is the point of offering it: low-bandwidth
+// backhauls get roughly an 8x uplink reduction over the 192 kbps MP3 stream.
+constexpr int OPUS_DEFAULT_BITRATE = 24000;
+// Encoder effort, 0 (fastest) to 10 (best quality). 5 keeps encode cheap on
+// small boards while staying transparent for voice at the default bitrate.
+constexpr int OPUS_DEFAULT_COMPLEXITY = 5;
+// 20ms frames - the codec's default tradeoff between latency and efficiency
+constexpr int OPUS_FRAME_MS = 20;
+// Recommended maximum packet size from the Opus documentation
+constexpr int OPUS_MAX_PACKET_BYTES = 4000;
+
+using audio::utils::CleanupPtr;
+
+// Opus only encodes at these rates; initialize_opus_encoder rejects others
+constexpr int OPUS_SUPPORTED_SAMPLE_RATES[] = {8000, 12000, 16000, 24000, 48000};
+
+struct OpusEncoderContext {
+    CleanupPtr<opus_encoder_destroy> encoder = nullptr;
+
+    int sample_rate = 0;
+    int num_channels = 0;
+    int bitrate = OPUS_DEFAULT_BITRATE;
+    int complexity = OPUS_DEFAULT_COMPLEXITY;
+
+    // Encoder lookahead (samples per channel) - the codec's analysis delay,
+    // analogous to LAME's encoder delay
+    int encoder_delay = 0;
+
+    // Samples per channel in one Opus frame (20ms at the session rate)
+    int frame_size = 0;
+
+    // Reused packet scratch so steady-state encode does not allocate
+    std::vector<uint8_t> packet_buffer;
+};
+
+bool is_opus_supported_sample_rate(int sample_rate);
+
+// Throws std::invalid_argument if sample_rate is not an Opus rate
+// (8/12/16/24/48 kHz), std::runtime_error on encoder creation failure
+void initialize_opus_encoder(OpusEncoderContext& ctx, int sample_rate, int num_channels, int bitrate, int complexity);
+
+// Encodes whole Opus frames from samples (interleaved pcm16; sample_count must
+// be a multiple of frame_size * num_channels, which the aligned chunk sizing
+// guarantees). Raw Opus packets are not self-delimiting, so each packet is
+// appended to output_data as [uint16 LE packet length][packet bytes] -
+// decode_opus_to_pcm16 consumes the same framing.
+void encode_samples_to_opus(
+    OpusEncoderContext& ctx, int16_t* samples, int sample_count, uint64_t chunk_start_position, std::vector<uint8_t>& output_data);
+
+void cleanup_opus_encoder(OpusEncoderContext& ctx);
+
+}  // namespace microphone
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Pointer-based pcm16 widening kernels shared by the codec conversion
+// functions (audio_codec.cpp) and the fused ring-read paths (audio_buffer.cpp).
+// Vectorized with SSE2 on x86-64 (baseline, no extra build flags needed) and
+// NEON on ARM, with a scalar tail/fallback. Kept in their own header so
+// audio_buffer can use them without pulling in the encoder contexts that
+// audio_codec.hpp drags along.
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace audio {
+
+constexpr float INT16_TO_FLOAT_SCALE = 1.0f / 32768.0f;  // Scale factor for converting int16 samples to float [-1.0, 1.0]
+
+namespace codec {
+
+inline void convert_pcm16_to_pcm32_samples(const int16_t* input, int32_t* output, size_t sample_count) noexcept {
+    size_t i = 0;
+#if defined(__SSE2__)
+    // 8 samples per iteration: interleaving zeros below each int16 yields
+    // exactly (sample << 16) in each int32 lane
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_unpacklo_epi16(zero, s));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 4), _mm_unpackhi_epi16(zero, s));
+    }
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    for (; i + 8 <= sample_count; i += 8) {
+        const int16x8_t s = vld1q_s16(input + i);
+        vst1q_s32(output + i, vshll_n_s16(vget_low_s16(s), 16));
+        vst1q_s32(output + i + 4, vshll_n_s16(vget_high_s16(s), 16));
+    }
+#endif
+    for (; i < sample_count; i++) {
+        output[i] = static_cast<int32_t>(input[i]) << 16;
+    }
+}
+
+inline void convert_pcm16_to_float32_samples(const int16_t* input, float* output, size_t sample_count) noexcept {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(audio::INT16_TO_FLOAT_SCALE);
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        // Sign-extend by interleaving into the high half then shifting back down
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(zero, s), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(zero, s), 16);
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    for (; i + 8 <= sample_count; i += 8) {
+        const int16x8_t s = vld1q_s16(input + i);
+        const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+        const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+        vst1q_f32(output + i, vmulq_n_f32(lo, audio::INT16_TO_FLOAT_SCALE));
+        vst1q_f32(output + i + 4, vmulq_n_f32(hi, audio::INT16_TO_FLOAT_SCALE));
+    }
+#endif
+    for (; i < sample_count; i++) {
+        output[i] = static_cast<float>(input[i]) * audio::INT16_TO_FLOAT_SCALE;
+    }
+}
+
+}  // namespace codec
+}  // namespace audio
@@ -1,11 +1,139 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include <sstream>
 #include <vector>
+#include "audio_utils.hpp"
 #include "soxr.h"
 
-// Resample PCM16 audio from one sample rate to another
+namespace audio {
+
+// Stateful streaming resampler built on a persistent soxr engine.
+//
+// soxr_oneshot designs the conversion filter and allocates a full engine on
+// every call, which dominates CPU at 100-150ms chunk sizes and discards filter
+// state between chunks, producing audible discontinuities at chunk edges.
+// A Resampler is created once per stream (when the requested sample rate
+// differs from the device rate) and fed chunks incrementally via process(),
+// carrying filter state across chunk boundaries.
+class Resampler {
+   public:
+    Resampler(int input_sample_rate, int output_sample_rate, int num_channels)
+        : input_sample_rate_(input_sample_rate), output_sample_rate_(output_sample_rate), num_channels_(num_channels) {
+        // Specify I/O format as int16 (default is float32)
+        const soxr_io_spec_t io_spec = soxr_io_spec(SOXR_INT16_I, SOXR_INT16_I);
+
+        soxr_error_t err = nullptr;
+        soxr_ = utils::CleanupPtr<soxr_delete>(soxr_create(input_sample_rate,
+                                                           output_sample_rate,
+                                                           num_channels,
+                                                           &err,
+                                                           &io_spec,
+                                                           NULL,
+                                                           NULL  // default quality and runtime configuration
+                                                           ));
+        if (!soxr_ || err) {
+            std::ostringstream buffer;
+            buffer << "failed to create resampler: " << soxr_strerror(err);
+            VIAM_SDK_LOG(error) << buffer.str();
+            throw std::runtime_error(buffer.str());
+        }
+    }
+
+    // Resample one chunk of interleaved int16 samples, filling output_samples
+    // with the samples the filter released. Output size varies slightly from
+    // chunk to chunk (the filter holds a few frames of delay internally).
+    void process(const int16_t* input_samples, size_t input_sample_count, std::vector<int16_t>& output_samples) {
+        output_samples.clear();
+        const size_t input_frames = input_sample_count / num_channels_;
+
+        size_t consumed_frames = 0;
+        while (consumed_frames < input_frames) {
+            // Enough room for the rate ratio of the remaining input plus any
+            // frames the filter releases from previous chunks
+            const size_t output_capacity_frames =
+                static_cast<size_t>(std::lround(static_cast<double>(input_frames - consumed_frames) * output_sample_rate_ /
+                                                input_sample_rate_)) +
+                OUTPUT_MARGIN_FRAMES;
+
+            const size_t base = output_samples.size();
+            output_samples.resize(base + output_capacity_frames * num_channels_);
+
+            size_t input_done_frames = 0;
+            size_t output_done_frames = 0;
+            const soxr_error_t err = soxr_process(soxr_.get(),
+                                                  input_samples + consumed_frames * num_channels_,
+                                                  input_frames - consumed_frames,
+                                                  &input_done_frames,
+                                                  output_samples.data() + base,
+                                                  output_capacity_frames,
+                                                  &output_done_frames);
+            if (err) {
+                std::ostringstream buffer;
+                buffer << "failed to resample: " << soxr_strerror(err);
+                VIAM_SDK_LOG(error) << buffer.str();
+                throw std::runtime_error(buffer.str());
+            }
+
+            output_samples.resize(base + output_done_frames * num_channels_);
+            consumed_frames += input_done_frames;
+
+            if (input_done_frames == 0 && output_done_frames == 0) {
+                // Engine made no progress - avoid spinning
+                break;
+            }
+        }
+    }
+
+    // Drain the frames still held in the filter at end of stream, appending
+    // them to output_samples.
+    void flush(std::vector<int16_t>& output_samples) {
+        while (true) {
+            const size_t base = output_samples.size();
+            output_samples.resize(base + OUTPUT_MARGIN_FRAMES * num_channels_);
+
+            size_t output_done_frames = 0;
+            // Null input signals end-of-input to soxr
+            const soxr_error_t err =
+                soxr_process(soxr_.get(), NULL, 0, NULL, output_samples.data() + base, OUTPUT_MARGIN_FRAMES, &output_done_frames);
+            if (err) {
+                std::ostringstream buffer;
+                buffer << "failed to flush resampler: " << soxr_strerror(err);
+                VIAM_SDK_LOG(error) << buffer.str();
+                throw std::runtime_error(buffer.str());
+            }
+
+            output_samples.resize(base + output_done_frames * num_channels_);
+            if (output_done_frames == 0) {
+                break;
+            }
+        }
+    }
+
+    int input_sample_rate() const noexcept {
+        return input_sample_rate_;
+    }
+    int output_sample_rate() const noexcept {
+        return output_sample_rate_;
+    }
+
+   private:
+    // Headroom added to per-chunk output capacity for frames released from the
+    // filter's internal delay line; also the flush drain block size (frames).
+    static constexpr size_t OUTPUT_MARGIN_FRAMES = 256;
+
+    utils::CleanupPtr<soxr_delete> soxr_;
+    int input_sample_rate_;
+    int output_sample_rate_;
+    int num_channels_;
+};
+
+}  // namespace audio
+
+// Resample PCM16 audio from one sample rate to another in a single shot.
+// Used for whole-clip conversion (speaker playback); streaming paths should
+// use audio::Resampler so filter state carries across chunk boundaries.
 // input_samples: pointer to input int16_t samples
 // input_sample_count: total number of samples (frames * channels)
 // output_samples: vector that will be resized and filled with resampled data
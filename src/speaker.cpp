@@ -1,4 +1,5 @@
 #include "speaker.hpp"
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 #include <thread>
@@ -9,6 +10,7 @@
 #include "audio_codec.hpp"
 #include "audio_utils.hpp"
 #include "mp3_decoder.hpp"
+#include "opus_decoder.hpp"
 #include "resample.hpp"
 #include "volume.hpp"
 
@@ -19,6 +21,18 @@ using audio::codec::AudioCodec;
 constexpr int MIN_VOLUME = 0;
 constexpr int MAX_VOLUME = 100;
 
+// Queued playback: poll cadence the scheduler uses while waiting for ring
+// space or completion, the bound on finished entries retained for status
+// queries, and the default wait_playback timeout
+constexpr int PLAYBACK_POLL_INTERVAL_MS = 10;
+constexpr size_t MAX_FINISHED_PLAYBACKS = 32;
+constexpr int DEFAULT_WAIT_PLAYBACK_TIMEOUT_MS = 30000;
+
+// Default byte budget for the decoded-audio cache (0 disables caching).
+// A 3 second 48kHz stereo pcm16 clip is ~576 KiB, so the default holds a
+// dozen or so typical alert/prompt sounds.
+constexpr size_t DEFAULT_DECODED_CACHE_BYTES = 8 * 1024 * 1024;
+
 Speaker::Speaker(viam::sdk::Dependencies deps, viam::sdk::ResourceConfig cfg, audio::portaudio::PortAudioInterface* pa)
     : viam::sdk::AudioOut(cfg.name()), pa_(pa), stream_(nullptr) {
     auto setup = audio::utils::setup_audio_device<audio::OutputStreamContext>(
@@ -28,20 +42,78 @@ Speaker::Speaker(viam::sdk::Dependencies deps, viam::sdk::ResourceConfig cfg, au
     {
         std::lock_guard<std::mutex> lock(stream_mu_);
         device_name_ = setup.stream_params.device_name;
+        asset_dir_ = setup.config_params.asset_dir;
         sample_rate_ = setup.stream_params.sample_rate;
         num_channels_ = setup.stream_params.num_channels;
         audio_context_ = setup.audio_context;
         setup.stream_params.user_data = setup.audio_context.get();
         audio::utils::restart_stream(stream_, setup.stream_params, pa_);
         latency_ = audio::utils::get_stream_latency(stream_, setup.stream_params, pa_);
+        stream_params_ = setup.stream_params;
+        config_params_ = setup.config_params;
         volume_ = setup.config_params.volume;
-        if (volume_) {
-            audio::volume::set_volume(device_name_, *volume_);
+    }
+
+    // Applied outside the lock - mixer setup is milliseconds of syscalls and
+    // the controller never needs stream_mu_
+    if (volume_) {
+        volume_ctl_.set(device_name_, *volume_);
+    }
+
+    decoded_cache_budget_bytes_ = static_cast<size_t>(setup.config_params.decoded_cache_bytes.value_or(DEFAULT_DECODED_CACHE_BYTES));
+
+    // Scheduler for queued playback - idle until a queued play arrives
+    scheduler_thread_ = std::thread(&Speaker::scheduler_loop, this);
+
+    // Hand stall recovery to the module supervisor - a stalled output stream
+    // restarts even when nothing is playing
+    supervisor_watch_ = audio::supervision::StreamSupervisor::instance().register_stream(
+        cfg.name(),
+        [this]() -> uint64_t {
+            std::lock_guard<std::mutex> lock(stream_mu_);
+            return audio_context_ ? audio_context_->last_callback_time_ns.load() : 0;
+        },
+        [this]() { restart_stalled_stream(); });
+}
+
+void Speaker::restart_stalled_stream() {
+    std::lock_guard<std::mutex> lock(stream_mu_);
+    if (!audio_context_) {
+        return;
+    }
+    VIAM_SDK_LOG(warn) << "[speaker] Restarting stalled output stream";
+    if (stream_) {
+        try {
+            audio::utils::abort_stream(stream_, pa_);
+        } catch (const std::exception& e) {
+            VIAM_SDK_LOG(error) << "[speaker] Error shutting down stalled stream: " << e.what();
         }
+        stream_ = nullptr;
     }
+    // Reopen against the same playback ring so queued and in-flight audio
+    // survives the restart - only the PortAudio stream is replaced
+    stream_params_.user_data = audio_context_.get();
+    audio::utils::restart_stream(stream_, stream_params_, pa_);
+    latency_ = audio::utils::get_stream_latency(stream_, stream_params_, pa_);
+    VIAM_SDK_LOG(info) << "[speaker] Output stream restarted successfully";
 }
 
 Speaker::~Speaker() {
+    // Unregister first: this blocks until any in-flight supervisor restart
+    // has returned, so the closures cannot touch a dead Speaker
+    if (supervisor_watch_ != 0) {
+        audio::supervision::StreamSupervisor::instance().unregister_stream(supervisor_watch_);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mu_);
+        scheduler_shutdown_ = true;
+    }
+    queue_cv_.notify_all();
+    if (scheduler_thread_.joinable()) {
+        scheduler_thread_.join();
+    }
+    cancel_queued_playback("shutdown");
+
     if (stream_) {
         PaError err = Pa_StopStream(stream_);
         if (err != paNoError) {
@@ -78,7 +150,12 @@ int speakerCallback(const void* inputBuffer,
 
     audio::OutputStreamContext* const ctx = static_cast<audio::OutputStreamContext*>(userData);
 
-    ctx->last_callback_time_ns.store(static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    const uint64_t now_ns = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const uint64_t prev_ns = ctx->last_callback_time_ns.exchange(now_ns);
+    if (prev_ns > 0) {
+        // One relaxed bucket increment - RT-safe jitter tracking
+        ctx->callback_interval_histogram.record(now_ns - prev_ns);
+    }
 
     if (statusFlags & paOutputOverflow) {
         ctx->output_overflow_count.fetch_add(1);
@@ -150,6 +227,23 @@ std::vector<std::string> Speaker::validate(vsdk::ResourceConfig cfg) {
             throw std::invalid_argument(" num_channels must be greater than zero");
         }
     }
+    if (attrs.count("asset_dir")) {
+        if (!attrs["asset_dir"].is_a<std::string>()) {
+            VIAM_SDK_LOG(error) << "[validate] asset_dir attribute must be a string";
+            throw std::invalid_argument("asset_dir attribute must be a string");
+        }
+    }
+    if (attrs.count("decoded_cache_bytes")) {
+        if (!attrs["decoded_cache_bytes"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] decoded_cache_bytes attribute must be a number";
+            throw std::invalid_argument("decoded_cache_bytes attribute must be a number");
+        }
+        const double cache_bytes = *attrs.at("decoded_cache_bytes").get<double>();
+        if (cache_bytes < 0) {
+            VIAM_SDK_LOG(error) << "[validate] decoded_cache_bytes must be non-negative";
+            throw std::invalid_argument("decoded_cache_bytes must be non-negative");
+        }
+    }
     if (attrs.count("volume")) {
         if (!attrs["volume"].is_a<double>()) {
             VIAM_SDK_LOG(error) << "[validate] volume attribute must be a number";
@@ -161,6 +255,17 @@ std::vector<std::string> Speaker::validate(vsdk::ResourceConfig cfg) {
             throw std::invalid_argument("volume must be between 0 and 100");
         }
     }
+    if (attrs.count("buffer_duration_seconds")) {
+        if (!attrs["buffer_duration_seconds"].is_a<double>()) {
+            VIAM_SDK_LOG(error) << "[validate] buffer_duration_seconds attribute must be a number";
+            throw std::invalid_argument("buffer_duration_seconds attribute must be a number");
+        }
+        const double buffer_duration_seconds = *attrs.at("buffer_duration_seconds").get<double>();
+        if (buffer_duration_seconds <= 0) {
+            VIAM_SDK_LOG(error) << "[validate] buffer_duration_seconds must be greater than zero";
+            throw std::invalid_argument("buffer_duration_seconds must be greater than zero");
+        }
+    }
 
     return {};
 }
@@ -175,9 +280,16 @@ viam::sdk::ProtoStruct Speaker::do_command(const viam::sdk::ProtoStruct& command
             throw std::invalid_argument("volume must be between 0 and 100");
         }
 
-        std::lock_guard<std::mutex> lock(stream_mu_);
-        audio::volume::set_volume(device_name_, vol);
-        volume_ = vol;
+        // Snapshot the device name under the lock, but apply the volume
+        // outside it so bursts of slider commands never stall the playback
+        // path - the controller itself coalesces them to the newest value
+        std::string device_name;
+        {
+            std::lock_guard<std::mutex> lock(stream_mu_);
+            device_name = device_name_;
+            volume_ = vol;
+        }
+        volume_ctl_.set(device_name, vol);
 
         return viam::sdk::ProtoStruct{{"volume", static_cast<double>(vol)}};
     }
@@ -186,34 +298,101 @@ viam::sdk::ProtoStruct Speaker::do_command(const viam::sdk::ProtoStruct& command
         VIAM_SDK_LOG(info) << "Stop command received, interrupting playback";
         stop_requested_.store(true);
         // Advance playback position to write position so no more audio is played.
-        std::lock_guard<std::mutex> lock(stream_mu_);
-        if (audio_context_) {
-            audio_context_->playback_position.store(audio_context_->get_write_position());
+        {
+            std::lock_guard<std::mutex> lock(stream_mu_);
+            if (audio_context_) {
+                audio_context_->playback_position.store(audio_context_->get_write_position());
+            }
         }
+        cancel_queued_playback("stop command");
         return viam::sdk::ProtoStruct{{"stopped", true}};
     }
 
-    throw std::invalid_argument("unknown command");
-}
+    if (command.count("play_file")) {
+        if (!command.at("play_file").is_a<std::string>()) {
+            throw std::invalid_argument("play_file must be a file name string");
+        }
+        const std::string file_name = *command.at("play_file").get<std::string>();
+        play_file(file_name);
+        return viam::sdk::ProtoStruct{{"played", file_name}};
+    }
 
-/**
- * Play audio data through the speaker.
- *
- * This method blocks until the audio has been completely played back.
- * Audio is written to an internal circular buffer and played asynchronously
- * by the PortAudio callback. The method waits until playback is complete
- * before returning.
- *
- * @throws std::invalid_argument if codec is not PCM_16 or data size is invalid
- */
-void Speaker::play(std::vector<uint8_t> const& audio_data,
-                   boost::optional<viam::sdk::audio_info> info,
-                   const viam::sdk::ProtoStruct& extra) {
-    std::lock_guard<std::mutex> playback_lock(playback_mu_);
-    stop_requested_.store(false);
+    if (command.count("play_status")) {
+        if (!command.at("play_status").is_a<double>()) {
+            throw std::invalid_argument("play_status must be a playback id number");
+        }
+        const uint64_t id = static_cast<uint64_t>(*command.at("play_status").get<double>());
 
-    VIAM_SDK_LOG(debug) << "Play called, adding samples to playback buffer";
+        std::lock_guard<std::mutex> lock(queue_mu_);
+        const auto it = playback_index_.find(id);
+        const std::string state = it != playback_index_.end() ? it->second->state : "unknown";
+        return viam::sdk::ProtoStruct{{"id", static_cast<double>(id)}, {"state", state}};
+    }
+
+    if (command.count("wait_playback")) {
+        if (!command.at("wait_playback").is_a<double>()) {
+            throw std::invalid_argument("wait_playback must be a playback id number");
+        }
+        const uint64_t id = static_cast<uint64_t>(*command.at("wait_playback").get<double>());
+        int timeout_ms = DEFAULT_WAIT_PLAYBACK_TIMEOUT_MS;
+        if (command.count("timeout_ms")) {
+            if (!command.at("timeout_ms").is_a<double>()) {
+                throw std::invalid_argument("timeout_ms must be a number");
+            }
+            timeout_ms = static_cast<int>(*command.at("timeout_ms").get<double>());
+        }
+
+        std::shared_future<void> done;
+        {
+            std::lock_guard<std::mutex> lock(queue_mu_);
+            const auto it = playback_index_.find(id);
+            if (it == playback_index_.end()) {
+                return viam::sdk::ProtoStruct{{"id", static_cast<double>(id)}, {"state", std::string("unknown")}};
+            }
+            done = it->second->done;
+        }
+        const bool finished = done.wait_for(std::chrono::milliseconds(timeout_ms)) == std::future_status::ready;
+
+        std::lock_guard<std::mutex> lock(queue_mu_);
+        const auto it = playback_index_.find(id);
+        const std::string state = it != playback_index_.end() ? it->second->state : "unknown";
+        return viam::sdk::ProtoStruct{{"id", static_cast<double>(id)}, {"state", state}, {"timed_out", !finished}};
+    }
+
+    if (command.count("playback_queue")) {
+        std::lock_guard<std::mutex> lock(queue_mu_);
+        return viam::sdk::ProtoStruct{{"pending", static_cast<double>(pending_.size())},
+                                      {"in_flight", static_cast<double>(in_flight_.size())},
+                                      {"next_id", static_cast<double>(next_playback_id_)}};
+    }
+
+    if (command.count("stats")) {
+        std::shared_ptr<audio::OutputStreamContext> ctx;
+        {
+            std::lock_guard<std::mutex> lock(stream_mu_);
+            ctx = audio_context_;
+        }
+        viam::sdk::ProtoStruct stats;
+        if (ctx) {
+            const uint64_t write_position = ctx->get_write_position();
+            const uint64_t playback_position = ctx->playback_position.load(std::memory_order_relaxed);
+            stats.emplace("samples_written", static_cast<double>(write_position));
+            stats.emplace("playback_position", static_cast<double>(playback_position));
+            stats.emplace("output_overflows", static_cast<double>(ctx->output_overflow_count.load(std::memory_order_relaxed)));
+            stats.emplace("output_underflows", static_cast<double>(ctx->output_underflow_count.load(std::memory_order_relaxed)));
+            stats.emplace("ring_capacity", static_cast<double>(ctx->buffer_capacity));
+            const uint64_t queued = write_position > playback_position ? write_position - playback_position : 0;
+            stats.emplace("ring_fill", ctx->buffer_capacity > 0 ? static_cast<double>(queued) / ctx->buffer_capacity : 0.0);
+            stats.emplace("callback_intervals", audio::utils::callback_histogram_to_proto(ctx->callback_interval_histogram));
+        }
+        return stats;
+    }
 
+    throw std::invalid_argument("unknown command");
+}
+
+std::vector<int16_t> Speaker::decode_to_speaker_format(const std::vector<uint8_t>& audio_data,
+                                                       const boost::optional<viam::sdk::audio_info>& info) {
     if (!info) {
         VIAM_SDK_LOG(error) << "[Play]: Must specify audio info parameter";
         throw std::invalid_argument("[Play]: Must specify audio info parameter");
@@ -238,6 +417,13 @@ void Speaker::play(std::vector<uint8_t> const& audio_data,
             audio_num_channels = mp3_ctx.num_channels;
             break;
         }
+        case AudioCodec::OPUS: {
+            // Opus packets carry no rate/channel metadata, so decode at the
+            // rates the client declared in the audio info
+            OpusDecoderContext opus_ctx;
+            decode_opus_to_pcm16(opus_ctx, audio_data, info->sample_rate_hz, info->num_channels, decoded_data);
+            break;
+        }
         case AudioCodec::PCM_32:
             audio::codec::convert_pcm32_to_pcm16(audio_data.data(), audio_data.size(), decoded_data);
             break;
@@ -265,11 +451,15 @@ void Speaker::play(std::vector<uint8_t> const& audio_data,
     size_t num_samples = decoded_data.size() / sizeof(int16_t);
 
     int speaker_sample_rate;
+    uint64_t ring_capacity = 0;
 
     // Validate decoded audio properties match speaker configuration
     {
         std::lock_guard<std::mutex> lock(stream_mu_);
         speaker_sample_rate = sample_rate_;
+        if (audio_context_) {
+            ring_capacity = audio_context_->buffer_capacity;
+        }
         if (audio_num_channels != num_channels_) {
             VIAM_SDK_LOG(error) << "Channel mismatch: speaker=" << num_channels_ << " channels, decoded audio=" << audio_num_channels
                                 << " channels";
@@ -279,38 +469,194 @@ void Speaker::play(std::vector<uint8_t> const& audio_data,
     }
 
     // Resample if sample rates don't match
-    std::vector<int16_t> resampled_samples;
-    const int16_t* samples = decoded_samples;
-    size_t final_num_samples = num_samples;
+    std::vector<int16_t> samples;
     int final_sample_rate = audio_sample_rate;
 
     if (audio_sample_rate != speaker_sample_rate) {
         VIAM_SDK_LOG(info) << "resampling audio from " << audio_sample_rate << "Hz to speaker native sample rate " << speaker_sample_rate
                            << " Hz";
-        resample_audio(audio_sample_rate, speaker_sample_rate, audio_num_channels, decoded_samples, num_samples, resampled_samples);
-
-        // Use resampled data
-        samples = resampled_samples.data();
-        final_num_samples = resampled_samples.size();
+        resample_audio(audio_sample_rate, speaker_sample_rate, audio_num_channels, decoded_samples, num_samples, samples);
         final_sample_rate = speaker_sample_rate;
+    } else {
+        samples.assign(decoded_samples, decoded_samples + num_samples);
     }
 
     // Check if audio duration exceeds playback buffer capacity
+    if (ring_capacity > 0 && samples.size() > ring_capacity) {
+        const double duration_seconds = static_cast<double>(samples.size()) / (final_sample_rate * audio_num_channels);
+        const double max_seconds = static_cast<double>(ring_capacity) / (final_sample_rate * audio_num_channels);
+        VIAM_SDK_LOG(error) << "Audio duration (" << duration_seconds << " seconds) exceeds maximum playback buffer size (" << max_seconds
+                            << " seconds)";
+        throw std::invalid_argument("Audio file too long for playback buffer (max " + std::to_string(max_seconds) + " seconds)");
+    }
+
+    return samples;
+}
+
+// FNV-1a: fast non-cryptographic hash, plenty for distinguishing the small
+// fixed set of clips a deployment replays
+static uint64_t fnv1a_64(const uint8_t* data, const size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t Speaker::decoded_cache_key(const std::vector<uint8_t>& audio_data,
+                                    const std::string& codec,
+                                    const int sample_rate,
+                                    const int num_channels) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = fnv1a_64(audio_data.data(), audio_data.size(), hash);
+    hash = fnv1a_64(reinterpret_cast<const uint8_t*>(codec.data()), codec.size(), hash);
+    // Same bytes played at a different target format decode differently
+    const int format[2] = {sample_rate, num_channels};
+    hash = fnv1a_64(reinterpret_cast<const uint8_t*>(format), sizeof(format), hash);
+    return hash;
+}
+
+bool Speaker::decoded_cache_enabled() {
+    std::lock_guard<std::mutex> lock(cache_mu_);
+    return decoded_cache_budget_bytes_ > 0;
+}
+
+std::shared_ptr<const std::vector<int16_t>> Speaker::decoded_cache_lookup(const uint64_t key) {
+    std::lock_guard<std::mutex> lock(cache_mu_);
+    const auto it = decoded_cache_index_.find(key);
+    if (it == decoded_cache_index_.end()) {
+        return nullptr;
+    }
+    // Move to the front of the LRU list
+    decoded_cache_lru_.splice(decoded_cache_lru_.begin(), decoded_cache_lru_, it->second);
+    return it->second->samples;
+}
+
+void Speaker::decoded_cache_insert(const uint64_t key, std::vector<int16_t> samples) {
+    const size_t entry_bytes = samples.size() * sizeof(int16_t);
+
+    std::lock_guard<std::mutex> lock(cache_mu_);
+    if (entry_bytes == 0 || entry_bytes > decoded_cache_budget_bytes_) {
+        return;
+    }
+    if (decoded_cache_index_.count(key)) {
+        // Concurrent play of the same clip already inserted it
+        return;
+    }
+
+    decoded_cache_lru_.push_front(
+        DecodedCacheEntry{key, std::make_shared<const std::vector<int16_t>>(std::move(samples))});
+    decoded_cache_index_[key] = decoded_cache_lru_.begin();
+    decoded_cache_bytes_used_ += entry_bytes;
+
+    // Evict least-recently-played entries until within budget
+    while (decoded_cache_bytes_used_ > decoded_cache_budget_bytes_ && !decoded_cache_lru_.empty()) {
+        const DecodedCacheEntry& oldest = decoded_cache_lru_.back();
+        decoded_cache_bytes_used_ -= oldest.samples->size() * sizeof(int16_t);
+        decoded_cache_index_.erase(oldest.key);
+        decoded_cache_lru_.pop_back();
+    }
+}
+
+/**
+ * Play audio data through the speaker.
+ *
+ * This method blocks until the audio has been completely played back.
+ * Audio is written to an internal circular buffer and played asynchronously
+ * by the PortAudio callback. The method waits until playback is complete
+ * before returning.
+ *
+ * With {"queued": true} in extra, the decoded audio is handed to the playback
+ * scheduler instead and play returns immediately; queued items are scheduled
+ * back-to-back into the ring and completion is observable via the
+ * play_status / wait_playback do_commands.
+ *
+ * @throws std::invalid_argument if codec is not PCM_16 or data size is invalid
+ */
+void Speaker::play(std::vector<uint8_t> const& audio_data,
+                   boost::optional<viam::sdk::audio_info> info,
+                   const viam::sdk::ProtoStruct& extra) {
+    VIAM_SDK_LOG(debug) << "Play called, adding samples to playback buffer";
+
+    if (!info) {
+        VIAM_SDK_LOG(error) << "[Play]: Must specify audio info parameter";
+        throw std::invalid_argument("[Play]: Must specify audio info parameter");
+    }
+
+    bool queued = false;
+    if (extra.count("queued")) {
+        const bool* flag = extra.at("queued").get<bool>();
+        if (flag != nullptr) {
+            queued = *flag;
+        }
+    }
+
+    // The cache applies where play would otherwise burn CPU: MP3 decode and
+    // resampling. A straight PCM_16 copy at the speaker rate is cheaper than
+    // the cache entry it would create.
+    int target_sample_rate;
+    int target_num_channels;
     {
         std::lock_guard<std::mutex> lock(stream_mu_);
-        double duration_seconds = static_cast<double>(final_num_samples) / (final_sample_rate * audio_num_channels);
-        if (duration_seconds > audio::BUFFER_DURATION_SECONDS) {
-            VIAM_SDK_LOG(error) << "Audio duration (" << duration_seconds << " seconds) exceeds maximum playback buffer size ("
-                                << audio::BUFFER_DURATION_SECONDS << " seconds)";
-            throw std::invalid_argument("Audio file too long for playback buffer (max " + std::to_string(audio::BUFFER_DURATION_SECONDS) +
-                                        " seconds)");
+        target_sample_rate = sample_rate_;
+        target_num_channels = num_channels_;
+    }
+    const AudioCodec codec = audio::codec::parse_codec(info->codec);
+    const bool cacheable = decoded_cache_enabled() &&
+                           (codec == AudioCodec::MP3 || codec == AudioCodec::OPUS || info->sample_rate_hz != target_sample_rate);
+    uint64_t cache_key = 0;
+    std::shared_ptr<const std::vector<int16_t>> prepared;
+    if (cacheable) {
+        cache_key = decoded_cache_key(audio_data, info->codec, target_sample_rate, target_num_channels);
+        prepared = decoded_cache_lookup(cache_key);
+        if (prepared) {
+            VIAM_SDK_LOG(debug) << "[play] decoded-audio cache hit (" << prepared->size() << " samples)";
         }
     }
 
+    if (!prepared) {
+        // Blocking MP3 playback streams frame-by-frame into the ring instead
+        // of decoding the whole file up front - playback starts after the
+        // first frame and no full-size intermediate copies are made. Queued
+        // playback keeps the whole-file decode since items must be fully
+        // prepared up front.
+        if (!queued && codec == AudioCodec::MP3) {
+            play_mp3_streaming(audio_data.data(), audio_data.size(), cacheable ? std::optional<uint64_t>(cache_key) : std::nullopt);
+            return;
+        }
+
+        std::vector<int16_t> decoded = decode_to_speaker_format(audio_data, info);
+        if (cacheable) {
+            decoded_cache_insert(cache_key, decoded);
+        }
+        prepared = std::make_shared<const std::vector<int16_t>>(std::move(decoded));
+    }
+    const size_t final_num_samples = prepared->size();
+
+    if (queued) {
+        auto item = std::make_shared<QueuedPlayback>();
+        item->samples = *prepared;
+        {
+            std::lock_guard<std::mutex> lock(queue_mu_);
+            item->id = next_playback_id_++;
+            playback_index_[item->id] = item;
+            pending_.push_back(item);
+        }
+        queue_cv_.notify_one();
+        VIAM_SDK_LOG(debug) << "[play] Queued playback " << item->id << " (" << final_num_samples << " samples)";
+        return;
+    }
+
+    std::lock_guard<std::mutex> playback_lock(playback_mu_);
+    stop_requested_.store(false);
+
+    const int16_t* samples = prepared->data();
+
     VIAM_SDK_LOG(debug) << "Playing " << final_num_samples << " samples (" << final_num_samples * sizeof(int16_t) << " bytes)";
 
-    // Write samples to the audio buffer and capture context
-    uint64_t start_position;
+    // Snapshot the context under the lock; the bulk copy below happens
+    // outside it so set_volume/stop/get_properties/reconfigure are never
+    // blocked behind a long write
     std::shared_ptr<audio::OutputStreamContext> playback_context;
     {
         std::lock_guard<std::mutex> lock(stream_mu_);
@@ -319,19 +665,30 @@ void Speaker::play(std::vector<uint8_t> const& audio_data,
             throw std::runtime_error("Audio context is nullptr");
         }
         playback_context = audio_context_;
-        start_position = audio_context_->get_write_position();
+    }
 
-        for (size_t i = 0; i < final_num_samples; i++) {
-            audio_context_->write_sample(samples[i]);
-        }
+    // Block-copy the samples into the ring in at most two memcpy segments.
+    // ring_write_mu_ serializes against the queued-playback scheduler - the
+    // ring is single-producer - and is held only for the copy itself.
+    uint64_t start_position;
+    {
+        std::lock_guard<std::mutex> lock(ring_write_mu_);
+        start_position = playback_context->get_write_position();
+        playback_context->write_samples(samples, final_num_samples);
     }
 
+    wait_for_playback(playback_context, start_position, final_num_samples);
+}
+
+void Speaker::wait_for_playback(const std::shared_ptr<audio::OutputStreamContext>& playback_context,
+                                const uint64_t start_position,
+                                const uint64_t num_samples) {
     // Block until playback position catches up
     VIAM_SDK_LOG(debug) << "Waiting for playback to complete...";
     uint64_t last_logged_overflow_count = 0;
     uint64_t last_logged_underflow_count = 0;
     uint64_t last_staleness_log_ns = 0;
-    while (playback_context->playback_position.load() - start_position < final_num_samples) {
+    while (playback_context->playback_position.load() - start_position < num_samples) {
         if (stop_requested_.load()) {
             VIAM_SDK_LOG(debug) << "Playback stopped by stop command";
             return;
@@ -372,11 +729,393 @@ void Speaker::play(std::vector<uint8_t> const& audio_data,
     VIAM_SDK_LOG(debug) << "Audio playback complete";
 }
 
+bool Speaker::stream_samples_into_ring(const std::shared_ptr<audio::OutputStreamContext>& playback_context,
+                                       const int16_t* samples,
+                                       const size_t count,
+                                       uint64_t& start_position,
+                                       uint64_t& samples_written) {
+    // Wait until the ring has room for count samples behind the playback
+    // position - this backpressure is what lets clips longer than the ring
+    // stream through it
+    while (true) {
+        if (stop_requested_.load()) {
+            VIAM_SDK_LOG(debug) << "Playback stopped by stop command";
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(stream_mu_);
+            if (audio_context_ != playback_context) {
+                VIAM_SDK_LOG(debug) << "Audio playback interrupted by reconfigure, exiting";
+                return false;
+            }
+        }
+        const uint64_t queued_ahead = playback_context->get_write_position() - playback_context->playback_position.load();
+        if (queued_ahead + count <= static_cast<uint64_t>(playback_context->buffer_capacity)) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(PLAYBACK_POLL_INTERVAL_MS));
+    }
+
+    std::lock_guard<std::mutex> lock(ring_write_mu_);
+    if (samples_written == 0) {
+        start_position = playback_context->get_write_position();
+    }
+    playback_context->write_samples(samples, count);
+    samples_written += count;
+    return true;
+}
+
+void Speaker::play_mp3_streaming(const uint8_t* audio_data, const size_t audio_size, const std::optional<uint64_t> cache_key) {
+    std::lock_guard<std::mutex> playback_lock(playback_mu_);
+    stop_requested_.store(false);
+
+    int speaker_sample_rate;
+    int speaker_num_channels;
+    std::shared_ptr<audio::OutputStreamContext> playback_context;
+    {
+        std::lock_guard<std::mutex> lock(stream_mu_);
+        if (!audio_context_) {
+            VIAM_SDK_LOG(error) << "[Play] Audio context is nullptr";
+            throw std::runtime_error("Audio context is nullptr");
+        }
+        playback_context = audio_context_;
+        speaker_sample_rate = sample_rate_;
+        speaker_num_channels = num_channels_;
+    }
+
+    MP3DecoderContext mp3_ctx;
+    // Created lazily once the decoder reports the file's sample rate; persists
+    // across frames so the filter state carries between chunks
+    std::unique_ptr<audio::Resampler> resampler;
+    std::vector<int16_t> resampled;
+    uint64_t start_position = 0;
+    uint64_t samples_written = 0;
+    bool interrupted = false;
+
+    // When caching, accumulate everything written to the ring so repeat plays
+    // skip the decode. Abandoned if the clip outgrows the cache budget or the
+    // ring capacity (a cached replay goes through the non-streaming path).
+    std::vector<int16_t> cache_samples;
+    bool caching = cache_key.has_value();
+    size_t cache_sample_limit = 0;
+    if (caching) {
+        std::lock_guard<std::mutex> lock(cache_mu_);
+        cache_sample_limit = decoded_cache_budget_bytes_ / sizeof(int16_t);
+        caching = cache_sample_limit > 0;
+    }
+    cache_sample_limit = std::min(cache_sample_limit, static_cast<size_t>(playback_context->buffer_capacity));
+
+    // Bulk-writes with backpressure; aborts the decode loop when playback was
+    // interrupted by stop or reconfigure
+    const auto write_to_ring = [&](const int16_t* samples, const size_t count) {
+        if (!stream_samples_into_ring(playback_context, samples, count, start_position, samples_written)) {
+            interrupted = true;
+            return false;
+        }
+        if (caching) {
+            if (samples_written <= cache_sample_limit) {
+                cache_samples.insert(cache_samples.end(), samples, samples + count);
+            } else {
+                caching = false;
+                cache_samples.clear();
+                cache_samples.shrink_to_fit();
+            }
+        }
+        return true;
+    };
+
+    decode_mp3_streaming(mp3_ctx, audio_data, audio_size, [&](const int16_t* samples, const int sample_count) {
+        if (mp3_ctx.num_channels != speaker_num_channels) {
+            VIAM_SDK_LOG(error) << "Channel mismatch: speaker=" << speaker_num_channels
+                                << " channels, decoded audio=" << mp3_ctx.num_channels << " channels";
+            throw std::invalid_argument("Channel mismatch: speaker=" + std::to_string(speaker_num_channels) +
+                                        " channels, decoded audio=" + std::to_string(mp3_ctx.num_channels) + " channels");
+        }
+        if (mp3_ctx.sample_rate == speaker_sample_rate) {
+            return write_to_ring(samples, static_cast<size_t>(sample_count));
+        }
+        if (!resampler) {
+            VIAM_SDK_LOG(info) << "resampling audio from " << mp3_ctx.sample_rate << "Hz to speaker native sample rate "
+                               << speaker_sample_rate << " Hz";
+            resampler = std::make_unique<audio::Resampler>(mp3_ctx.sample_rate, speaker_sample_rate, mp3_ctx.num_channels);
+        }
+        resampler->process(samples, static_cast<size_t>(sample_count), resampled);
+        if (resampled.empty()) {
+            // The filter may hold the first few frames as internal delay
+            return true;
+        }
+        return write_to_ring(resampled.data(), resampled.size());
+    });
+
+    // Drain the frames the resampler still holds at end of stream
+    if (!interrupted && resampler) {
+        resampled.clear();
+        resampler->flush(resampled);
+        if (!resampled.empty()) {
+            write_to_ring(resampled.data(), resampled.size());
+        }
+    }
+
+    if (interrupted || samples_written == 0) {
+        return;
+    }
+
+    if (caching && !cache_samples.empty()) {
+        decoded_cache_insert(*cache_key, std::move(cache_samples));
+    }
+
+    wait_for_playback(playback_context, start_position, samples_written);
+}
+
+// Samples fed through resampling and into the ring per iteration when
+// streaming a mapped file - bounds the transient heap regardless of file size
+constexpr size_t FILE_STREAM_WINDOW_SAMPLES = 32768;
+
+void Speaker::play_file(const std::string& file_name) {
+    std::string asset_dir;
+    {
+        std::lock_guard<std::mutex> lock(stream_mu_);
+        asset_dir = asset_dir_;
+    }
+    if (asset_dir.empty()) {
+        VIAM_SDK_LOG(error) << "[play_file] asset_dir is not configured";
+        throw std::invalid_argument("[play_file] requires the asset_dir attribute to be configured");
+    }
+    // File names resolve inside the asset directory only
+    if (file_name.empty() || file_name.front() == '/' || file_name.find("..") != std::string::npos) {
+        VIAM_SDK_LOG(error) << "[play_file] invalid file name: " << file_name;
+        throw std::invalid_argument("[play_file] file name must be a relative path inside asset_dir");
+    }
+    const std::string path = asset_dir + "/" + file_name;
+
+    VIAM_SDK_LOG(info) << "[play_file] Playing " << path;
+    audio::file::MappedFile mapped(path);
+
+    if (audio::file::is_wav(mapped.data(), mapped.size())) {
+        play_wav_streaming(audio::file::parse_wav_pcm16(mapped.data(), mapped.size()));
+    } else {
+        // Anything that isn't RIFF/WAVE is handed to the MP3 decoder, which
+        // scans for a frame sync and rejects everything else
+        play_mp3_streaming(mapped.data(), mapped.size(), std::nullopt);
+    }
+}
+
+void Speaker::play_wav_streaming(const audio::file::WavPcm16& wav) {
+    std::lock_guard<std::mutex> playback_lock(playback_mu_);
+    stop_requested_.store(false);
+
+    int speaker_sample_rate;
+    int speaker_num_channels;
+    std::shared_ptr<audio::OutputStreamContext> playback_context;
+    {
+        std::lock_guard<std::mutex> lock(stream_mu_);
+        if (!audio_context_) {
+            VIAM_SDK_LOG(error) << "[Play] Audio context is nullptr";
+            throw std::runtime_error("Audio context is nullptr");
+        }
+        playback_context = audio_context_;
+        speaker_sample_rate = sample_rate_;
+        speaker_num_channels = num_channels_;
+    }
+
+    if (wav.num_channels != speaker_num_channels) {
+        VIAM_SDK_LOG(error) << "Channel mismatch: speaker=" << speaker_num_channels << " channels, decoded audio=" << wav.num_channels
+                            << " channels";
+        throw std::invalid_argument("Channel mismatch: speaker=" + std::to_string(speaker_num_channels) +
+                                    " channels, decoded audio=" + std::to_string(wav.num_channels) + " channels");
+    }
+
+    std::unique_ptr<audio::Resampler> resampler;
+    if (wav.sample_rate != speaker_sample_rate) {
+        VIAM_SDK_LOG(info) << "resampling audio from " << wav.sample_rate << "Hz to speaker native sample rate " << speaker_sample_rate
+                           << " Hz";
+        resampler = std::make_unique<audio::Resampler>(wav.sample_rate, speaker_sample_rate, wav.num_channels);
+    }
+
+    std::vector<int16_t> resampled;
+    uint64_t start_position = 0;
+    uint64_t samples_written = 0;
+    bool interrupted = false;
+
+    // Walk the mapped data chunk in bounded windows, reading straight from
+    // the page cache
+    size_t offset = 0;
+    while (offset < wav.num_samples) {
+        const size_t window = std::min(FILE_STREAM_WINDOW_SAMPLES, wav.num_samples - offset);
+        bool ok = true;
+        if (resampler) {
+            resampler->process(wav.samples + offset, window, resampled);
+            if (!resampled.empty()) {
+                ok = stream_samples_into_ring(playback_context, resampled.data(), resampled.size(), start_position, samples_written);
+            }
+        } else {
+            ok = stream_samples_into_ring(playback_context, wav.samples + offset, window, start_position, samples_written);
+        }
+        if (!ok) {
+            interrupted = true;
+            break;
+        }
+        offset += window;
+    }
+
+    // Drain the frames the resampler still holds at end of stream
+    if (!interrupted && resampler) {
+        resampled.clear();
+        resampler->flush(resampled);
+        if (!resampled.empty()) {
+            interrupted = !stream_samples_into_ring(playback_context, resampled.data(), resampled.size(), start_position, samples_written);
+        }
+    }
+
+    if (interrupted || samples_written == 0) {
+        return;
+    }
+
+    wait_for_playback(playback_context, start_position, samples_written);
+}
+
+void Speaker::scheduler_loop() {
+    while (true) {
+        std::shared_ptr<QueuedPlayback> item;
+        {
+            std::unique_lock<std::mutex> lock(queue_mu_);
+            // The bounded wait doubles as the completion poll cadence for
+            // in-flight items when nothing is pending
+            queue_cv_.wait_for(lock, std::chrono::milliseconds(PLAYBACK_POLL_INTERVAL_MS),
+                               [this] { return scheduler_shutdown_ || !pending_.empty(); });
+            if (scheduler_shutdown_) {
+                return;
+            }
+            if (!pending_.empty()) {
+                item = pending_.front();
+            }
+        }
+
+        std::shared_ptr<audio::OutputStreamContext> ctx;
+        {
+            std::lock_guard<std::mutex> lock(stream_mu_);
+            ctx = audio_context_;
+        }
+        if (!ctx) {
+            continue;
+        }
+
+        // Complete any in-flight items the callback has played past
+        {
+            std::lock_guard<std::mutex> lock(queue_mu_);
+            reap_finished_locked(ctx->playback_position.load());
+        }
+
+        if (!item) {
+            continue;
+        }
+
+        // Schedule the next item only once the ring can hold all of it behind
+        // the playback position - items land directly after one another, so
+        // back-to-back clips play gaplessly
+        const uint64_t queued_ahead = ctx->get_write_position() - ctx->playback_position.load();
+        if (queued_ahead + item->samples.size() > static_cast<uint64_t>(ctx->buffer_capacity)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(PLAYBACK_POLL_INTERVAL_MS));
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stream_mu_);
+            if (audio_context_ != ctx) {
+                // Reconfigured mid-wait - re-evaluate against the new context
+                continue;
+            }
+        }
+
+        // Bulk copy outside stream_mu_; ring_write_mu_ keeps the ring
+        // single-producer against a concurrent blocking play
+        {
+            std::lock_guard<std::mutex> lock(ring_write_mu_);
+            ctx->write_samples(item->samples.data(), item->samples.size());
+            item->end_position = ctx->get_write_position();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mu_);
+            if (!pending_.empty() && pending_.front() == item) {
+                pending_.pop_front();
+            }
+            item->samples.clear();
+            item->samples.shrink_to_fit();
+            // A stop/reconfigure may have cancelled the item while it was
+            // being written - only a still-queued item advances to playing
+            if (item->state == "queued") {
+                item->state = "playing";
+                in_flight_.push_back(item);
+            }
+        }
+    }
+}
+
+void Speaker::reap_finished_locked(uint64_t playback_position) {
+    while (!in_flight_.empty() && in_flight_.front()->end_position <= playback_position) {
+        const auto item = in_flight_.front();
+        in_flight_.pop_front();
+        if (item->state == "playing") {
+            item->state = "done";
+            item->completion.set_value();
+            finished_ids_.push_back(item->id);
+        }
+    }
+    // Bound how many finished entries stay queryable
+    while (finished_ids_.size() > MAX_FINISHED_PLAYBACKS) {
+        playback_index_.erase(finished_ids_.front());
+        finished_ids_.pop_front();
+    }
+}
+
+void Speaker::cancel_queued_playback(const std::string& reason) {
+    std::lock_guard<std::mutex> lock(queue_mu_);
+    size_t cancelled = 0;
+    const auto cancel_item = [&](const std::shared_ptr<QueuedPlayback>& item) {
+        if (item->state == "queued" || item->state == "playing") {
+            item->state = "stopped";
+            item->completion.set_value();
+            finished_ids_.push_back(item->id);
+            cancelled++;
+        }
+    };
+    for (const auto& item : pending_) {
+        cancel_item(item);
+    }
+    for (const auto& item : in_flight_) {
+        cancel_item(item);
+    }
+    pending_.clear();
+    in_flight_.clear();
+    while (finished_ids_.size() > MAX_FINISHED_PLAYBACKS) {
+        playback_index_.erase(finished_ids_.front());
+        finished_ids_.pop_front();
+    }
+    if (cancelled > 0) {
+        VIAM_SDK_LOG(info) << "[play] Cancelled " << cancelled << " queued playback item(s): " << reason;
+    }
+}
+
+void Speaker::apply_decoded_cache_budget(size_t budget_bytes) {
+    std::lock_guard<std::mutex> lock(cache_mu_);
+    decoded_cache_budget_bytes_ = budget_bytes;
+    while (decoded_cache_bytes_used_ > decoded_cache_budget_bytes_ && !decoded_cache_lru_.empty()) {
+        const DecodedCacheEntry& oldest = decoded_cache_lru_.back();
+        decoded_cache_bytes_used_ -= oldest.samples->size() * sizeof(int16_t);
+        decoded_cache_index_.erase(oldest.key);
+        decoded_cache_lru_.pop_back();
+    }
+}
+
 viam::sdk::audio_properties Speaker::get_properties(const vsdk::ProtoStruct& extra) {
     viam::sdk::audio_properties props;
 
-    props.supported_codecs = {
-        vsdk::audio_codecs::PCM_16, vsdk::audio_codecs::PCM_32, vsdk::audio_codecs::PCM_32_FLOAT, vsdk::audio_codecs::MP3};
+    props.supported_codecs = {vsdk::audio_codecs::PCM_16,
+                              vsdk::audio_codecs::PCM_32,
+                              vsdk::audio_codecs::PCM_32_FLOAT,
+                              vsdk::audio_codecs::MP3,
+                              audio::codec::OPUS_CODEC_NAME};
     std::lock_guard<std::mutex> lock(stream_mu_);
     props.sample_rate_hz = sample_rate_;
     props.num_channels = num_channels_;
@@ -392,6 +1131,35 @@ void Speaker::reconfigure(const vsdk::Dependencies& deps, const vsdk::ResourceCo
     VIAM_SDK_LOG(info) << "[reconfigure] Speaker reconfigure start";
 
     try {
+        // Fast path: when the pushed config leaves every stream-affecting
+        // attribute untouched (fleet-wide pushes usually do), apply the
+        // remaining attributes in place - the live stream, queued playback,
+        // and any unplayed ring audio all survive.
+        const auto new_params = audio::utils::parseConfigAttributes(cfg);
+        {
+            bool stream_unchanged = false;
+            std::string device_name;
+            {
+                std::lock_guard<std::mutex> lock(stream_mu_);
+                if (stream_ != nullptr && !audio::utils::stream_affecting_config_changed(config_params_, new_params)) {
+                    asset_dir_ = new_params.asset_dir;
+                    volume_ = new_params.volume;
+                    config_params_ = new_params;
+                    device_name = device_name_;
+                    stream_unchanged = true;
+                }
+            }
+            if (stream_unchanged) {
+                // Same device, so the cached mixer handle stays valid
+                if (new_params.volume) {
+                    volume_ctl_.set(device_name, *new_params.volume);
+                }
+                apply_decoded_cache_budget(static_cast<size_t>(new_params.decoded_cache_bytes.value_or(DEFAULT_DECODED_CACHE_BYTES)));
+                VIAM_SDK_LOG(info) << "[reconfigure] Stream parameters unchanged, applied config without stream restart";
+                return;
+            }
+        }
+
         // Check if there's unplayed audio before reconfiguring
         {
             std::lock_guard<std::mutex> lock(stream_mu_);
@@ -421,15 +1189,30 @@ void Speaker::reconfigure(const vsdk::Dependencies& deps, const vsdk::ResourceCo
             setup.stream_params.user_data = setup.audio_context.get();
             audio::utils::restart_stream(stream_, setup.stream_params, pa_);
             device_name_ = setup.stream_params.device_name;
+            asset_dir_ = setup.config_params.asset_dir;
             sample_rate_ = setup.stream_params.sample_rate;
             num_channels_ = setup.stream_params.num_channels;
             latency_ = audio::utils::get_stream_latency(stream_, setup.stream_params, pa_);
             audio_context_ = setup.audio_context;
+            stream_params_ = setup.stream_params;
+            config_params_ = setup.config_params;
             volume_ = setup.config_params.volume;
-            if (volume_) {
-                audio::volume::set_volume(device_name_, *volume_);
-            }
         }
+
+        // The device (and its ALSA card) may have changed - drop the cached
+        // mixer handle and apply the configured volume outside stream_mu_
+        volume_ctl_.invalidate();
+        if (setup.config_params.volume) {
+            volume_ctl_.set(setup.stream_params.device_name, *setup.config_params.volume);
+        }
+
+        // Apply the new cache budget and trim to fit. Entries keyed under the
+        // old target format simply stop matching and age out via LRU.
+        apply_decoded_cache_budget(static_cast<size_t>(setup.config_params.decoded_cache_bytes.value_or(DEFAULT_DECODED_CACHE_BYTES)));
+
+        // Queued items target the discarded context - cancel them rather than
+        // playing stale audio through the new stream
+        cancel_queued_playback("reconfigure");
         VIAM_SDK_LOG(info) << "[reconfigure] Reconfigure completed successfully";
     } catch (const std::exception& e) {
         VIAM_SDK_LOG(error) << "[reconfigure] Reconfigure failed: " << e.what();
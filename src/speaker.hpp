@@ -1,18 +1,29 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <viam/sdk/common/audio.hpp>
 #include <viam/sdk/components/audio_out.hpp>
 #include <viam/sdk/config/resource.hpp>
 #include <viam/sdk/resource/reconfigurable.hpp>
+#include "audio_file.hpp"
 #include "audio_stream.hpp"
+#include "audio_utils.hpp"
+#include "stream_supervisor.hpp"
 #include "portaudio.h"
 #include "portaudio.hpp"
+#include "volume.hpp"
 
 namespace speaker {
 namespace vsdk = ::viam::sdk;
@@ -33,6 +44,29 @@ struct SpeakerConfigParams {
     std::optional<double> latency_ms;
 };
 
+// One entry in the decoded-audio LRU cache: the final decoded-and-resampled
+// pcm16 for a clip, keyed by a hash of the input bytes plus the target format
+struct DecodedCacheEntry {
+    uint64_t key = 0;
+    std::shared_ptr<const std::vector<int16_t>> samples;
+};
+
+// One queued playback item: audio already decoded and resampled to the
+// speaker's native pcm16 format, waiting for (or undergoing) playback.
+// States advance queued -> playing -> done, or to stopped if cancelled by
+// the stop command, a reconfigure, or shutdown.
+struct QueuedPlayback {
+    uint64_t id = 0;
+    // Pending samples; cleared once written into the playback ring
+    std::vector<int16_t> samples;
+    // Ring position just past the item's last sample, set when scheduled
+    uint64_t end_position = 0;
+    std::string state = "queued";
+    // Fulfilled exactly once when the item finishes or is cancelled
+    std::promise<void> completion;
+    std::shared_future<void> done{completion.get_future().share()};
+};
+
 int speakerCallback(const void* inputBuffer,
                     void* outputBuffer,
                     unsigned long framesPerBuffer,
@@ -50,14 +84,98 @@ class Speaker final : public viam::sdk::AudioOut, public viam::sdk::Reconfigurab
 
     viam::sdk::ProtoStruct do_command(const viam::sdk::ProtoStruct& command);
 
+    // Reopens the PortAudio stream against the existing playback ring after
+    // the supervisor detects a callback stall. Queued and in-flight audio
+    // survives - only the stream itself is replaced.
+    void restart_stalled_stream();
+
+    // Plays audio through the speaker. Blocks until playback completes by
+    // default; with {"queued": true} in extra, enqueues the decoded audio and
+    // returns immediately. Queued items get sequential ids (starting at 1)
+    // and are scheduled gaplessly back-to-back; completion can be observed
+    // via the play_status / wait_playback do_commands.
     void play(std::vector<uint8_t> const& audio_data, boost::optional<viam::sdk::audio_info> info, const viam::sdk::ProtoStruct& extra);
 
     viam::sdk::audio_properties get_properties(const viam::sdk::ProtoStruct& extra);
     std::vector<viam::sdk::GeometryConfig> get_geometries(const viam::sdk::ProtoStruct& extra);
     void reconfigure(const viam::sdk::Dependencies& deps, const viam::sdk::ResourceConfig& cfg);
 
+    // Decodes audio_data to pcm16 at the speaker's native sample rate,
+    // validating the channel count against the speaker configuration and the
+    // duration against the playback buffer capacity. Shared by blocking and
+    // queued play.
+    std::vector<int16_t> decode_to_speaker_format(const std::vector<uint8_t>& audio_data,
+                                                  const boost::optional<viam::sdk::audio_info>& info);
+
+    // Streaming MP3 playback path used by blocking play: decodes frame by
+    // frame into a reusable buffer, resamples incrementally, and writes into
+    // the playback ring as frames become available, so output starts after
+    // the first frame instead of after full-file decode. Ring-space
+    // backpressure means clips are not limited to the ring's capacity.
+    void play_mp3_streaming(const uint8_t* audio_data, size_t audio_size, std::optional<uint64_t> cache_key);
+
+    // Plays a WAV or MP3 file from the configured asset directory, streaming
+    // the memory-mapped contents through decode into the ring in bounded
+    // windows. Arbitrarily long files play with O(window) heap; the
+    // ring-capacity duration limit does not apply. Blocks until playback
+    // completes; stop interrupts it.
+    void play_file(const std::string& file_name);
+
+    // Streaming pcm16 playback of a mapped WAV data chunk, resampling in
+    // bounded windows when the file rate differs from the speaker rate
+    void play_wav_streaming(const audio::file::WavPcm16& wav);
+
+    // Decoded-audio cache: repeat plays of the same input bytes at the same
+    // target format skip decode and resample entirely. Entries are evicted
+    // least-recently-played once the configured byte budget is exceeded.
+    static uint64_t decoded_cache_key(const std::vector<uint8_t>& audio_data,
+                                      const std::string& codec,
+                                      int sample_rate,
+                                      int num_channels);
+    bool decoded_cache_enabled();
+    std::shared_ptr<const std::vector<int16_t>> decoded_cache_lookup(uint64_t key);
+    void decoded_cache_insert(uint64_t key, std::vector<int16_t> samples);
+
+    // Blocks until the playback position passes start_position + num_samples,
+    // then waits out the output latency. Returns early on stop or reconfigure.
+    void wait_for_playback(const std::shared_ptr<audio::OutputStreamContext>& playback_context,
+                           uint64_t start_position,
+                           uint64_t num_samples);
+
+    // Waits for ring space behind the playback position, then bulk-writes
+    // count samples, recording the ring position of the first write in
+    // start_position. Returns false when playback was interrupted by stop or
+    // reconfigure.
+    bool stream_samples_into_ring(const std::shared_ptr<audio::OutputStreamContext>& playback_context,
+                                  const int16_t* samples,
+                                  size_t count,
+                                  uint64_t& start_position,
+                                  uint64_t& samples_written);
+
+    // Scheduler thread body: writes pending queued items gaplessly into the
+    // playback ring as space frees, and completes items once the playback
+    // position passes them
+    void scheduler_loop();
+
+    // Marks in-flight items whose samples have fully played as done and
+    // fulfills their completion futures. Caller must hold queue_mu_.
+    void reap_finished_locked(uint64_t playback_position);
+
+    // Cancels all pending and in-flight queued items, marking them stopped
+    // and fulfilling their futures. Must NOT be called holding queue_mu_.
+    void cancel_queued_playback(const std::string& reason);
+
+    // Applies a new decoded-audio cache budget and evicts LRU entries until
+    // usage fits. Takes cache_mu_ itself.
+    void apply_decoded_cache_budget(size_t budget_bytes);
+
     // Member variables
     std::string device_name_;
+    // Cached ALSA mixer - applies volume without reopening the mixer per call
+    // and is safe to use without stream_mu_
+    audio::volume::VolumeController volume_ctl_;
+    // Directory play_file resolves file names against; empty disables play_file
+    std::string asset_dir_;
     double latency_;
     int sample_rate_;
     int num_channels_;
@@ -73,11 +191,48 @@ class Speaker final : public viam::sdk::AudioOut, public viam::sdk::Reconfigurab
     // Protects stream_, audio_context_, and stream configuration
     std::mutex stream_mu_;
 
+    // Serializes producers of the playback ring (blocking play and the
+    // queued-playback scheduler) - held only for the bulk copy itself, never
+    // across decode or playback waits
+    std::mutex ring_write_mu_;
+
     // Audio context for speaker playback (includes buffer and playback position tracking)
     std::shared_ptr<audio::OutputStreamContext> audio_context_;
 
     // Flag to interrupt playback
     std::atomic<bool> stop_requested_{false};
+
+    // Decoded-audio LRU cache (front = most recently played). Guarded by
+    // cache_mu_, including the byte budget, which reconfigure may change.
+    std::mutex cache_mu_;
+    std::list<DecodedCacheEntry> decoded_cache_lru_;
+    std::unordered_map<uint64_t, std::list<DecodedCacheEntry>::iterator> decoded_cache_index_;
+    size_t decoded_cache_bytes_used_ = 0;
+    size_t decoded_cache_budget_bytes_ = 0;
+
+    // Queued playback state: pending items waiting for ring space, in-flight
+    // items already written to the ring, and an id index kept for status
+    // queries (finished entries are retained up to a small bound)
+    std::mutex queue_mu_;
+    std::condition_variable queue_cv_;
+    std::deque<std::shared_ptr<QueuedPlayback>> pending_;
+    std::deque<std::shared_ptr<QueuedPlayback>> in_flight_;
+    std::map<uint64_t, std::shared_ptr<QueuedPlayback>> playback_index_;
+    std::deque<uint64_t> finished_ids_;
+    uint64_t next_playback_id_ = 1;
+    bool scheduler_shutdown_ = false;
+    std::thread scheduler_thread_;
+
+    // Stream open parameters retained so a supervisor-triggered restart can
+    // reopen the same device/format. Guarded by stream_mu_.
+    audio::utils::StreamParams stream_params_;
+    // Parsed attributes behind the current stream, retained so reconfigure
+    // can diff a pushed config against them and skip the stream teardown when
+    // only stream-irrelevant attributes changed. Guarded by stream_mu_.
+    audio::utils::ConfigParams config_params_;
+    // Registration with the module-wide stream supervisor, which owns stall
+    // detection and restart for the output stream
+    audio::supervision::StreamSupervisor::WatchId supervisor_watch_ = 0;
 };
 
 }  // namespace speaker
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <viam/sdk/common/utils.hpp>
+
+namespace audio {
+namespace supervision {
+
+// How often the supervisor sweeps registered streams for staleness
+constexpr int SUPERVISOR_SWEEP_INTERVAL_MS = 500;
+// Exponential backoff between restart attempts on a stream that keeps
+// failing to come back - doubles per failure up to the cap, and resets as
+// soon as the stream's callback is observed firing again
+constexpr int RESTART_BACKOFF_INITIAL_MS = 1000;
+constexpr int RESTART_BACKOFF_MAX_MS = 60000;
+
+// Process-wide supervisor that owns stall detection and recovery for all
+// registered component streams. Components register two closures: a staleness
+// probe (steady-clock ns of the most recent real-time callback, 0 if none has
+// fired yet) and a restart action that throws on failure. A single background
+// thread sweeps the watches on a fixed cadence and triggers restarts with
+// exponential backoff, so:
+//   - a stalled stream recovers even with no connected clients,
+//   - the first client to connect never pays detection-plus-restart latency,
+//   - N waiting readers no longer race to trigger the same restart.
+// The get_audio read loops keep their staleness and xrun logging but no
+// longer drive recovery.
+class StreamSupervisor {
+   public:
+    using WatchId = uint64_t;
+
+    static StreamSupervisor& instance() {
+        static StreamSupervisor supervisor;
+        return supervisor;
+    }
+
+    // Intervals are injectable so tests can run sweeps at millisecond cadence
+    explicit StreamSupervisor(std::chrono::milliseconds sweep_interval = std::chrono::milliseconds(SUPERVISOR_SWEEP_INTERVAL_MS),
+                              std::chrono::milliseconds stale_threshold = std::chrono::milliseconds(STREAM_SUPERVISOR_STALE_MS),
+                              std::chrono::milliseconds backoff_initial = std::chrono::milliseconds(RESTART_BACKOFF_INITIAL_MS),
+                              std::chrono::milliseconds backoff_max = std::chrono::milliseconds(RESTART_BACKOFF_MAX_MS))
+        : sweep_interval_(sweep_interval),
+          stale_threshold_(stale_threshold),
+          backoff_initial_(backoff_initial),
+          backoff_max_(backoff_max) {}
+
+    ~StreamSupervisor() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            shutdown_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    StreamSupervisor(const StreamSupervisor&) = delete;
+    StreamSupervisor& operator=(const StreamSupervisor&) = delete;
+
+    // Registers a stream for supervision. name is used in logs only. The
+    // closures are invoked from the supervisor thread, must stay valid until
+    // unregister_stream returns, and must not call back into the supervisor.
+    WatchId register_stream(std::string name, std::function<uint64_t()> last_callback_ns, std::function<void()> restart) {
+        std::lock_guard<std::mutex> lock(mu_);
+        const WatchId id = next_id_++;
+        Watch& watch = watches_[id];
+        watch.name = std::move(name);
+        watch.last_callback_ns = std::move(last_callback_ns);
+        watch.restart = std::move(restart);
+        watch.backoff = backoff_initial_;
+        if (!thread_.joinable()) {
+            thread_ = std::thread(&StreamSupervisor::sweep_loop, this);
+        }
+        return id;
+    }
+
+    // Removes a watch and blocks until any in-flight sweep invocation of its
+    // closures has returned, so the owning component can be destroyed
+    // immediately after. Must not be called while holding a lock the
+    // registered closures take.
+    void unregister_stream(WatchId id) {
+        // Taking sweep_mu_ waits out a sweep that may be mid-invocation
+        std::lock_guard<std::mutex> sweep_lock(sweep_mu_);
+        std::lock_guard<std::mutex> lock(mu_);
+        watches_.erase(id);
+    }
+
+    // One staleness pass over all watches - the sweep thread's body, exposed
+    // so tests can drive sweeps deterministically
+    void sweep_once() {
+        std::lock_guard<std::mutex> sweep_lock(sweep_mu_);
+        const auto now = std::chrono::steady_clock::now();
+
+        // Staleness probes are cheap and run under the registry lock; restart
+        // closures take component locks and can block for seconds, so they
+        // are collected here and invoked outside it
+        struct Candidate {
+            WatchId id;
+            std::string name;
+            std::function<void()> restart;
+        };
+        std::vector<Candidate> to_restart;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            for (auto& [id, watch] : watches_) {
+                const uint64_t last_cb = watch.last_callback_ns();
+                if (last_cb == 0) {
+                    continue;  // no callback yet - stream still starting
+                }
+                const uint64_t now_ns = static_cast<uint64_t>(now.time_since_epoch().count());
+                const auto stale = std::chrono::nanoseconds(now_ns > last_cb ? now_ns - last_cb : 0);
+                if (stale <= stale_threshold_) {
+                    // Healthy - reset the backoff so the next stall starts fresh
+                    watch.backoff = backoff_initial_;
+                    watch.next_attempt = {};
+                    continue;
+                }
+                if (watch.next_attempt != std::chrono::steady_clock::time_point{} && now < watch.next_attempt) {
+                    continue;  // still backing off from a failed attempt
+                }
+                to_restart.push_back({id, watch.name, watch.restart});
+            }
+        }
+
+        for (auto& candidate : to_restart) {
+            bool failed = false;
+            try {
+                VIAM_SDK_LOG(warn) << "[supervisor] Stream '" << candidate.name << "' stalled, attempting restart";
+                candidate.restart();
+            } catch (const std::exception& e) {
+                failed = true;
+                VIAM_SDK_LOG(error) << "[supervisor] Restart of stream '" << candidate.name << "' failed: " << e.what();
+            }
+            std::lock_guard<std::mutex> lock(mu_);
+            auto it = watches_.find(candidate.id);
+            if (it == watches_.end()) {
+                continue;  // unregistered while restarting
+            }
+            if (failed) {
+                it->second.next_attempt = now + it->second.backoff;
+                it->second.backoff = std::min(it->second.backoff * 2, backoff_max_);
+            } else {
+                // Give the restarted stream one stale window before the next
+                // check so it is not immediately re-restarted while the first
+                // callback is still pending
+                it->second.next_attempt = now + stale_threshold_;
+            }
+        }
+    }
+
+   private:
+    // Matches STREAM_RESTART_THRESHOLD_MS in audio_utils.hpp; duplicated here
+    // so this header stays free of the utils include graph
+    static constexpr int STREAM_SUPERVISOR_STALE_MS = 2000;
+
+    struct Watch {
+        std::string name;
+        std::function<uint64_t()> last_callback_ns;
+        std::function<void()> restart;
+        std::chrono::milliseconds backoff{RESTART_BACKOFF_INITIAL_MS};
+        // Earliest time of the next restart attempt; default = no restriction
+        std::chrono::steady_clock::time_point next_attempt{};
+    };
+
+    void sweep_loop() {
+        std::unique_lock<std::mutex> lock(mu_);
+        while (!shutdown_) {
+            cv_.wait_for(lock, sweep_interval_, [this] { return shutdown_; });
+            if (shutdown_) {
+                return;
+            }
+            lock.unlock();
+            sweep_once();
+            lock.lock();
+        }
+    }
+
+    const std::chrono::milliseconds sweep_interval_;
+    const std::chrono::milliseconds stale_threshold_;
+    const std::chrono::milliseconds backoff_initial_;
+    const std::chrono::milliseconds backoff_max_;
+
+    // Registry lock: watches_, next_id_, shutdown_. Held across staleness
+    // probes but never while a restart closure runs.
+    std::mutex mu_;
+    // Held for the duration of each sweep's closure invocations so
+    // unregister_stream can wait out an in-flight call
+    std::mutex sweep_mu_;
+    std::condition_variable cv_;
+    bool shutdown_ = false;
+    WatchId next_id_ = 1;
+    std::map<WatchId, Watch> watches_;
+    std::thread thread_;
+};
+
+}  // namespace supervision
+}  // namespace audio
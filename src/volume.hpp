@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <viam/sdk/common/utils.hpp>
 #include "audio_utils.hpp"
@@ -30,76 +32,164 @@ inline std::string extract_alsa_card(const std::string& device_name) {
     VIAM_SDK_LOG(warn) << "[set_volume] Couldn't find device card, falling back to default";
     return "default";
 }
+#endif
 
-inline void set_volume(const std::string& device_name, int volume) {
-    const std::string card = extract_alsa_card(device_name);
-
-    VIAM_SDK_LOG(debug) << "[set_volume] Setting ALSA volume to " << volume << " on card " << card;
-
-    snd_mixer_t* mixer_ptr = nullptr;
-    if (int err = snd_mixer_open(&mixer_ptr, 0); err < 0) {
-        VIAM_SDK_LOG(error) << "[set_volume] Failed to open ALSA mixer: " << snd_strerror(err);
-        return;
+// Applies playback volume through ALSA with a cached mixer handle.
+// Opening a mixer (open, attach, register, load - walking the whole element
+// list) costs ~5-10ms of syscalls on a Pi, so the handle and resolved volume
+// element are opened once per card and reused; set() on a warm cache is a
+// single syscall. Bursts of set() calls coalesce to the newest value: the
+// thread currently applying picks up later requests, and callers that lost
+// the race return immediately. Safe to call without holding the speaker's
+// stream_mu_.
+class VolumeController {
+   public:
+    // Records volume as the latest requested value and applies it (or leaves
+    // it for the thread already applying). Returns immediately on a lost race.
+    void set(const std::string& device_name, int volume) {
+        pending_.store(volume, std::memory_order_relaxed);
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mu_, std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    // Another thread is mid-apply and will pick up pending_
+                    // (its post-unlock re-check below covers the window where
+                    // it already drained its last request)
+                    return;
+                }
+                int target = pending_.exchange(-1, std::memory_order_relaxed);
+                while (target != -1) {
+                    apply_locked(device_name, target);
+                    target = pending_.exchange(-1, std::memory_order_relaxed);
+                }
+            }
+            // A caller may have stored pending_ and failed the try_to_lock
+            // after our final exchange but before the unlock above - without
+            // this re-check that value would sit unapplied until an unrelated
+            // set(). Retake the lock and drain it.
+            if (pending_.load(std::memory_order_relaxed) == -1) {
+                return;
+            }
+        }
     }
-    audio::utils::CleanupPtr<snd_mixer_close> mixer(mixer_ptr);
 
-    // Connect alsa mixer to our device's sound card
-    if (int err = snd_mixer_attach(mixer.get(), card.c_str()); err < 0) {
-        VIAM_SDK_LOG(error) << "[set_volume] Failed to attach mixer to card: " << card << " :  " << snd_strerror(err);
-        return;
+    // Drops the cached mixer handle so the next set() reopens it. Called on
+    // reconfigure - the device (and its card) may have changed, and an
+    // externally restarted sound server invalidates old handles too.
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mu_);
+#ifdef __linux__
+        elem_ = nullptr;
+        mixer_ = nullptr;
+        card_.clear();
+#endif
     }
 
-    // Register simple element class to access high-level volume control
-    if (int err = snd_mixer_selem_register(mixer.get(), nullptr, nullptr); err < 0) {
-        VIAM_SDK_LOG(error) << "[set_volume] Failed to register mixer elements: " << snd_strerror(err);
-        return;
-    }
+   private:
+#ifdef __linux__
+    void apply_locked(const std::string& device_name, int volume) {
+        const std::string card = extract_alsa_card(device_name);
 
-    // load elements (controls of the mixer)
-    if (int err = snd_mixer_load(mixer.get()); err < 0) {
-        VIAM_SDK_LOG(error) << "[set_volume] Failed to load mixer elements: " << snd_strerror(err);
-        return;
-    }
+        VIAM_SDK_LOG(debug) << "[set_volume] Setting ALSA volume to " << volume << " on card " << card;
 
-    // Try "PCM" first (most common for Pi), then "Master"
-    snd_mixer_selem_id_t* sid = nullptr;
-    snd_mixer_selem_id_alloca(&sid);
-
-    // Volume control elements will either be called PCM, Master or Speaker depending on the device
-    const char* element_names[] = {"PCM", "Master", "Speaker"};
-    snd_mixer_elem_t* elem = nullptr;
-
-    for (const char* name : element_names) {
-        snd_mixer_selem_id_set_index(sid, 0);
-        snd_mixer_selem_id_set_name(sid, name);
-        elem = snd_mixer_find_selem(mixer.get(), sid);
-        if (elem) {
-            VIAM_SDK_LOG(debug) << "[set_volume] Found mixer element: " << name;
-            break;
+        if (!ensure_mixer_locked(card)) {
+            return;
         }
-    }
 
-    if (!elem) {
-        VIAM_SDK_LOG(error) << "[set_volume] Could not find PCM or Master mixer element";
-        return;
+        long min = 0;
+        long max = 0;
+        snd_mixer_selem_get_playback_volume_range(elem_, &min, &max);
+
+        const long target = min + (max - min) * volume / 100;
+        if (int err = snd_mixer_selem_set_playback_volume_all(elem_, target); err < 0) {
+            VIAM_SDK_LOG(error) << "[set_volume] Failed to set playback volume: " << snd_strerror(err);
+            // The handle may be stale (e.g. device unplugged) - drop it so the
+            // next call retries from a fresh mixer
+            elem_ = nullptr;
+            mixer_ = nullptr;
+            card_.clear();
+        }
     }
 
-    long min = 0;
-    long max = 0;
-    snd_mixer_selem_get_playback_volume_range(elem, &min, &max);
+    // Opens the mixer and resolves the volume element for card, reusing the
+    // cached handle when the card is unchanged
+    bool ensure_mixer_locked(const std::string& card) {
+        if (mixer_ && elem_ && card_ == card) {
+            return true;
+        }
+        elem_ = nullptr;
+        mixer_ = nullptr;
+        card_.clear();
+
+        snd_mixer_t* mixer_ptr = nullptr;
+        if (int err = snd_mixer_open(&mixer_ptr, 0); err < 0) {
+            VIAM_SDK_LOG(error) << "[set_volume] Failed to open ALSA mixer: " << snd_strerror(err);
+            return false;
+        }
+        audio::utils::CleanupPtr<snd_mixer_close> mixer(mixer_ptr);
+
+        // Connect alsa mixer to our device's sound card
+        if (int err = snd_mixer_attach(mixer.get(), card.c_str()); err < 0) {
+            VIAM_SDK_LOG(error) << "[set_volume] Failed to attach mixer to card: " << card << " :  " << snd_strerror(err);
+            return false;
+        }
 
-    const long target = min + (max - min) * volume / 100;
-    if (int err = snd_mixer_selem_set_playback_volume_all(elem, target); err < 0) {
-        VIAM_SDK_LOG(error) << "[set_volume] Failed to set playback volume: " << snd_strerror(err);
+        // Register simple element class to access high-level volume control
+        if (int err = snd_mixer_selem_register(mixer.get(), nullptr, nullptr); err < 0) {
+            VIAM_SDK_LOG(error) << "[set_volume] Failed to register mixer elements: " << snd_strerror(err);
+            return false;
+        }
+
+        // load elements (controls of the mixer)
+        if (int err = snd_mixer_load(mixer.get()); err < 0) {
+            VIAM_SDK_LOG(error) << "[set_volume] Failed to load mixer elements: " << snd_strerror(err);
+            return false;
+        }
+
+        snd_mixer_selem_id_t* sid = nullptr;
+        snd_mixer_selem_id_alloca(&sid);
+
+        // Volume control elements will either be called PCM, Master or Speaker depending on the device
+        const char* element_names[] = {"PCM", "Master", "Speaker"};
+        snd_mixer_elem_t* elem = nullptr;
+
+        for (const char* name : element_names) {
+            snd_mixer_selem_id_set_index(sid, 0);
+            snd_mixer_selem_id_set_name(sid, name);
+            elem = snd_mixer_find_selem(mixer.get(), sid);
+            if (elem) {
+                VIAM_SDK_LOG(debug) << "[set_volume] Found mixer element: " << name;
+                break;
+            }
+        }
+
+        if (!elem) {
+            VIAM_SDK_LOG(error) << "[set_volume] Could not find PCM or Master mixer element";
+            return false;
+        }
+
+        mixer_ = std::move(mixer);
+        elem_ = elem;
+        card_ = card;
+        return true;
     }
-}
 
+    // Cached mixer handle and resolved element - elem_ points into mixer_'s
+    // element list and is only valid while mixer_ is open
+    audio::utils::CleanupPtr<snd_mixer_close> mixer_ = nullptr;
+    snd_mixer_elem_t* elem_ = nullptr;
+    std::string card_;
 #else
-inline void set_volume(const std::string& /*device_name*/, int /*volume*/) {
-    VIAM_SDK_LOG(warn) << "[set_volume] Volume attribute is not supported on this platform";
-}
-
+    void apply_locked(const std::string& /*device_name*/, int /*volume*/) {
+        VIAM_SDK_LOG(warn) << "[set_volume] Volume attribute is not supported on this platform";
+    }
 #endif
 
+    // Serializes mixer access; set() never blocks on it thanks to try_to_lock
+    std::mutex mu_;
+    // Latest requested volume, -1 when none pending
+    std::atomic<int> pending_{-1};
+};
+
 }  // namespace volume
 }  // namespace audio
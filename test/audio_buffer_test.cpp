@@ -41,6 +41,66 @@ TEST_F(AudioBufferTest, WriteAndReadSamples) {
 }
 
 
+TEST_F(AudioBufferTest, BulkWriteAndReadSamples) {
+    std::vector<int16_t> test_samples(500);
+    for (size_t i = 0; i < test_samples.size(); i++) {
+        test_samples[i] = static_cast<int16_t>(i);
+    }
+
+    buffer_->write_samples(test_samples.data(), test_samples.size());
+    EXPECT_EQ(buffer_->get_write_position(), test_samples.size());
+
+    std::vector<int16_t> read_buffer(test_samples.size());
+    uint64_t read_pos = 0;
+    int samples_read = buffer_->read_samples(read_buffer.data(), test_samples.size(), read_pos);
+
+    EXPECT_EQ(samples_read, test_samples.size());
+    EXPECT_EQ(read_buffer, test_samples);
+}
+
+TEST_F(AudioBufferTest, BulkWriteWrapsAroundBufferEnd) {
+    // Advance the write position so the next bulk write straddles the ring end
+    const int capacity = buffer_->buffer_capacity;
+    std::vector<int16_t> filler(capacity - 100, 0);
+    buffer_->write_samples(filler.data(), filler.size());
+
+    std::vector<int16_t> test_samples(200);
+    for (size_t i = 0; i < test_samples.size(); i++) {
+        test_samples[i] = static_cast<int16_t>(i + 1);
+    }
+    buffer_->write_samples(test_samples.data(), test_samples.size());
+    EXPECT_EQ(buffer_->get_write_position(), filler.size() + test_samples.size());
+
+    // Read back across the wrap point
+    std::vector<int16_t> read_buffer(test_samples.size());
+    uint64_t read_pos = filler.size();
+    int samples_read = buffer_->read_samples(read_buffer.data(), test_samples.size(), read_pos);
+
+    EXPECT_EQ(samples_read, test_samples.size());
+    EXPECT_EQ(read_buffer, test_samples);
+}
+
+TEST_F(AudioBufferTest, BulkWriteLargerThanCapacityKeepsMostRecent) {
+    const int capacity = buffer_->buffer_capacity;
+    std::vector<int16_t> test_samples(capacity + 100);
+    for (size_t i = 0; i < test_samples.size(); i++) {
+        test_samples[i] = static_cast<int16_t>(i % 1000);
+    }
+
+    buffer_->write_samples(test_samples.data(), test_samples.size());
+    // Only the last `capacity` samples are retained; position reflects what was kept
+    EXPECT_EQ(buffer_->get_write_position(), capacity);
+
+    std::vector<int16_t> read_buffer(capacity);
+    uint64_t read_pos = 0;
+    int samples_read = buffer_->read_samples(read_buffer.data(), capacity, read_pos);
+
+    EXPECT_EQ(samples_read, capacity);
+    // The oldest retained sample should be the 100th input sample
+    EXPECT_EQ(read_buffer[0], test_samples[100]);
+    EXPECT_EQ(read_buffer[capacity - 1], test_samples.back());
+}
+
 TEST_F(AudioBufferTest, ReadPartialSamples) {
     // Write 100 samples
     const int num_samples = 100;
@@ -140,6 +200,91 @@ TEST_F(AudioBufferTest, ReadSampleNotYetWritten) {
     EXPECT_EQ(read_pos, 100);
 }
 
+TEST_F(AudioBufferTest, ReadIntoPcm16MatchesReadSamplesAcrossWrap) {
+    // Fill most of the ring, then write past the end so a read spans the wrap
+    const int capacity = buffer_->buffer_capacity;
+    for (int i = 0; i < capacity - 10; i++) {
+        buffer_->write_sample(static_cast<int16_t>(i));
+    }
+    for (int i = 0; i < 20; i++) {
+        buffer_->write_sample(static_cast<int16_t>(1000 + i));
+    }
+
+    const int read_count = 20;
+    uint64_t expected_pos = buffer_->get_write_position() - read_count;
+    std::vector<int16_t> expected(read_count);
+    ASSERT_EQ(buffer_->read_samples(expected.data(), read_count, expected_pos), read_count);
+
+    uint64_t fused_pos = buffer_->get_write_position() - read_count;
+    std::vector<uint8_t> fused(read_count * sizeof(int16_t));
+    ASSERT_EQ(buffer_->read_into_pcm16(fused.data(), read_count, fused_pos), read_count);
+    EXPECT_EQ(fused_pos, expected_pos);
+    EXPECT_EQ(std::memcmp(fused.data(), expected.data(), fused.size()), 0);
+}
+
+TEST_F(AudioBufferTest, ReadIntoPcm32ConvertsDirectly) {
+    std::vector<int16_t> samples = {-32768, -1, 0, 1, 32767};
+    for (auto sample : samples) {
+        buffer_->write_sample(sample);
+    }
+
+    uint64_t pos = 0;
+    std::vector<uint8_t> out(samples.size() * sizeof(int32_t));
+    ASSERT_EQ(buffer_->read_into_pcm32(out.data(), samples.size(), pos), static_cast<int>(samples.size()));
+    EXPECT_EQ(pos, samples.size());
+
+    const int32_t* converted = reinterpret_cast<const int32_t*>(out.data());
+    for (size_t i = 0; i < samples.size(); i++) {
+        EXPECT_EQ(converted[i], static_cast<int32_t>(samples[i]) << 16);
+    }
+}
+
+TEST_F(AudioBufferTest, ReadIntoFloat32Normalizes) {
+    std::vector<int16_t> samples = {-32768, 0, 16384, 32767};
+    for (auto sample : samples) {
+        buffer_->write_sample(sample);
+    }
+
+    uint64_t pos = 0;
+    std::vector<uint8_t> out(samples.size() * sizeof(float));
+    ASSERT_EQ(buffer_->read_into_float32(out.data(), samples.size(), pos), static_cast<int>(samples.size()));
+
+    const float* converted = reinterpret_cast<const float*>(out.data());
+    for (size_t i = 0; i < samples.size(); i++) {
+        EXPECT_FLOAT_EQ(converted[i], static_cast<float>(samples[i]) / 32768.0f);
+    }
+}
+
+TEST(CallbackIntervalHistogramTest, RecordsIntoCorrectBuckets) {
+    audio::CallbackIntervalHistogram histogram;
+
+    // 0.5ms -> first bucket (< 1ms)
+    histogram.record(500'000);
+    // 3ms -> < 5ms bucket (index 2)
+    histogram.record(3'000'000);
+    histogram.record(3'000'000);
+    // 700ms -> overflow bucket
+    histogram.record(700'000'000);
+
+    EXPECT_EQ(histogram.bucket_count(0), 1u);
+    EXPECT_EQ(histogram.bucket_count(2), 2u);
+    EXPECT_EQ(histogram.bucket_count(audio::CallbackIntervalHistogram::NUM_BUCKETS - 1), 1u);
+
+    // Untouched buckets stay zero
+    EXPECT_EQ(histogram.bucket_count(1), 0u);
+    EXPECT_EQ(histogram.bucket_count(5), 0u);
+}
+
+TEST(CallbackIntervalHistogramTest, BoundaryIntervalGoesToNextBucket) {
+    audio::CallbackIntervalHistogram histogram;
+
+    // Exactly 1ms is not < 1ms, so it lands in the < 2ms bucket
+    histogram.record(1'000'000);
+
+    EXPECT_EQ(histogram.bucket_count(0), 0u);
+    EXPECT_EQ(histogram.bucket_count(1), 1u);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     ::testing::AddGlobalTestEnvironment(new test_utils::AudioTestEnvironment);
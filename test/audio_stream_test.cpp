@@ -85,6 +85,32 @@ TEST_F(InputStreamContextTest, MultipleReadersIndependent) {
 
 
 
+TEST_F(InputStreamContextTest, WaitForWritePositionReturnsImmediatelyWhenAvailable) {
+    for (int i = 0; i < 100; i++) {
+        context_->write_sample(static_cast<int16_t>(i));
+    }
+
+    // Threshold already reached - should not block
+    EXPECT_TRUE(context_->wait_for_write_position(100, std::chrono::milliseconds(0)));
+}
+
+TEST_F(InputStreamContextTest, WaitForWritePositionTimesOutWhenNoSamples) {
+    EXPECT_FALSE(context_->wait_for_write_position(100, std::chrono::milliseconds(20)));
+}
+
+TEST_F(InputStreamContextTest, WaitForWritePositionWokenByWriter) {
+    std::thread writer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::vector<int16_t> samples(100, 42);
+        context_->write_samples(samples.data(), samples.size());
+        context_->notify_samples_written();
+    });
+
+    // Should be woken by the writer well before the timeout
+    EXPECT_TRUE(context_->wait_for_write_position(100, std::chrono::seconds(5)));
+    writer.join();
+}
+
 TEST_F(InputStreamContextTest, CalculateSampleTimestamp) {
     // Set up the baseline time
     context_->first_sample_adc_time = 1000.0;
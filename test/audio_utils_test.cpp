@@ -203,6 +203,88 @@ TEST_F(AudioUtilsTest, SetupStreamFromConfigInputFallsBackToDeviceDefaultWhenSam
     EXPECT_EQ(stream_params.sample_rate, test_utils::DEFAULT_DEVICE_SAMPLE_RATE);
 }
 
+TEST_F(AudioUtilsTest, SetupStreamFromConfigNegotiatesWidestCaptureFormat) {
+    using ::testing::Return;
+    // Device accepts everything - the widest candidate (int32) should win
+    ON_CALL(*mock_pa_, isFormatSupported(::testing::_, ::testing::_, ::testing::_))
+        .WillByDefault(Return(paNoError));
+
+    audio::utils::ConfigParams params;
+    params.device_name = "";
+
+    auto stream_params = audio::utils::setupStreamFromConfig(
+        params,
+        audio::utils::StreamDirection::Input,
+        nullptr,
+        mock_pa_.get()
+    );
+
+    EXPECT_EQ(stream_params.sample_format, paInt32);
+}
+
+TEST_F(AudioUtilsTest, SetupStreamFromConfigFallsBackThroughCaptureFormatCandidates) {
+    using ::testing::Invoke;
+    // Device rejects int32 but accepts int24 - negotiation should land on int24
+    ON_CALL(*mock_pa_, isFormatSupported(::testing::_, ::testing::_, ::testing::_))
+        .WillByDefault(Invoke([](const PaStreamParameters* input, const PaStreamParameters*, double) -> PaError {
+            if (input && input->sampleFormat == paInt32) {
+                return paSampleFormatNotSupported;
+            }
+            return paNoError;
+        }));
+
+    audio::utils::ConfigParams params;
+    params.device_name = "";
+
+    auto stream_params = audio::utils::setupStreamFromConfig(
+        params,
+        audio::utils::StreamDirection::Input,
+        nullptr,
+        mock_pa_.get()
+    );
+
+    EXPECT_EQ(stream_params.sample_format, paInt24);
+}
+
+TEST_F(AudioUtilsTest, SetupStreamFromConfigCaptureFormatInt16SkipsNegotiation) {
+    audio::utils::ConfigParams params;
+    params.device_name = "";
+    params.capture_format = "int16";
+
+    auto stream_params = audio::utils::setupStreamFromConfig(
+        params,
+        audio::utils::StreamDirection::Input,
+        nullptr,
+        mock_pa_.get()
+    );
+
+    EXPECT_EQ(stream_params.sample_format, paInt16);
+}
+
+TEST_F(AudioUtilsTest, SetupStreamFromConfigPinnedCaptureFormatFallsBackWhenUnsupported) {
+    using ::testing::Invoke;
+    ON_CALL(*mock_pa_, isFormatSupported(::testing::_, ::testing::_, ::testing::_))
+        .WillByDefault(Invoke([](const PaStreamParameters* input, const PaStreamParameters*, double) -> PaError {
+            if (input && input->sampleFormat == paFloat32) {
+                return paSampleFormatNotSupported;
+            }
+            return paNoError;
+        }));
+
+    audio::utils::ConfigParams params;
+    params.device_name = "";
+    params.capture_format = "float32";
+
+    auto stream_params = audio::utils::setupStreamFromConfig(
+        params,
+        audio::utils::StreamDirection::Input,
+        nullptr,
+        mock_pa_.get()
+    );
+
+    EXPECT_EQ(stream_params.sample_format, paInt16);
+}
+
 TEST_F(AudioUtilsTest, SetupStreamFromConfigOutputDirection) {
     using ::testing::Return;
 
@@ -0,0 +1,255 @@
+// Synthetic multi-client load harness for the Microphone get_audio pipeline.
+//
+// Drives a Microphone through the MockPortAudio seam with a deterministic
+// synthetic callback source (a 440 Hz tone written at real 10ms callback
+// cadence), fans out N concurrent get_audio sessions round-robined across
+// codecs (pcm16, pcm32_float, mp3, opus), and reports per-codec chunk delivery
+// latency percentiles, aggregate CPU, and heap allocation counts over a timed
+// run. The requested rate (16 kHz) differs from the mock device rate
+// (44.1 kHz) so every session also exercises the resampling path.
+//
+// This is not a unit test and is not registered with ctest - build it with the
+// test tree and run it directly:
+//
+//     ./load_harness [clients] [seconds]     (defaults: 6 clients, 10 seconds)
+//
+// Use it to compare concurrency behavior (fan-out, shared encode stages, lock
+// changes) across revisions without deploying to hardware.
+
+#include <gmock/gmock.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include <viam/sdk/common/audio.hpp>
+#include <viam/sdk/common/instance.hpp>
+#include <viam/sdk/config/resource.hpp>
+#include "microphone.hpp"
+#include "test_utils.hpp"
+
+// Global heap allocation counter. Replacing operator new here counts every
+// allocation in the process, including the harness's own bookkeeping - the
+// number is only meaningful as a delta between revisions, not as an absolute.
+static std::atomic<uint64_t> g_alloc_count{0};
+
+void* operator new(std::size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr int DEVICE_SAMPLE_RATE = test_utils::DEFAULT_DEVICE_SAMPLE_RATE;
+constexpr int REQUESTED_SAMPLE_RATE = 16000;  // != device rate, forces resampling
+constexpr int NUM_CHANNELS = 1;
+constexpr int CALLBACK_PERIOD_MS = 10;
+constexpr int FRAMES_PER_CALLBACK = DEVICE_SAMPLE_RATE * CALLBACK_PERIOD_MS / 1000;
+
+// Per-client measurement: wall-clock delivery latency of each chunk, measured
+// as (now - chunk end timestamp) when the chunk handler runs
+struct ClientResult {
+    std::string codec;
+    std::vector<int64_t> latencies_ns;
+    uint64_t chunks = 0;
+    uint64_t bytes = 0;
+};
+
+// Simulated capture callback: writes a deterministic 440 Hz tone into the
+// capture ring at real callback cadence and maintains the liveness fields the
+// real AudioCallback would (so the stall watchdog stays quiet and the interval
+// histogram fills in).
+void run_synthetic_source(std::shared_ptr<audio::InputStreamContext> ctx, std::atomic<bool>& stop) {
+    std::vector<int16_t> block(FRAMES_PER_CALLBACK * NUM_CHANNELS);
+    uint64_t sample_index = 0;
+    auto next_deadline = std::chrono::steady_clock::now();
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        for (int frame = 0; frame < FRAMES_PER_CALLBACK; frame++) {
+            const double t = static_cast<double>(sample_index + frame) / DEVICE_SAMPLE_RATE;
+            const int16_t sample = static_cast<int16_t>(12000.0 * std::sin(2.0 * M_PI * 440.0 * t));
+            for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+                block[frame * NUM_CHANNELS + ch] = sample;
+            }
+        }
+        sample_index += FRAMES_PER_CALLBACK;
+
+        ctx->write_samples(block.data(), block.size());
+        const uint64_t now_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        const uint64_t prev_ns = ctx->last_callback_time_ns.exchange(now_ns);
+        if (prev_ns > 0) {
+            ctx->callback_interval_histogram.record(now_ns - prev_ns);
+        }
+        ctx->notify_samples_written();
+
+        next_deadline += std::chrono::milliseconds(CALLBACK_PERIOD_MS);
+        std::this_thread::sleep_until(next_deadline);
+    }
+}
+
+int64_t percentile(std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    const std::size_t index = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1));
+    return sorted[index];
+}
+
+double rusage_cpu_seconds(const rusage& ru) {
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 + ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int num_clients = argc > 1 ? std::atoi(argv[1]) : 6;
+    const double run_seconds = argc > 2 ? std::atof(argv[2]) : 10.0;
+    if (num_clients <= 0 || run_seconds <= 0) {
+        std::fprintf(stderr, "usage: %s [clients] [seconds]\n", argv[0]);
+        return 1;
+    }
+
+    viam::sdk::Instance instance;
+
+    // Mock PortAudio with the same defaults the unit test fixtures use
+    ::testing::NiceMock<test_utils::MockPortAudio> mock_pa;
+    PaDeviceInfo device_info{};
+    device_info.defaultLowInputLatency = 0.01;
+    device_info.defaultSampleRate = DEVICE_SAMPLE_RATE;
+    device_info.maxInputChannels = 2;
+    device_info.maxOutputChannels = 2;
+    device_info.name = "Load Harness Device";
+    ON_CALL(mock_pa, getDefaultInputDevice()).WillByDefault(::testing::Return(0));
+    ON_CALL(mock_pa, getDeviceInfo(::testing::_)).WillByDefault(::testing::Return(&device_info));
+    ON_CALL(mock_pa, getDeviceCount()).WillByDefault(::testing::Return(1));
+    ON_CALL(mock_pa, openStream(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_,
+                                ::testing::_))
+        .WillByDefault(::testing::Return(paNoError));
+    ON_CALL(mock_pa, startStream(::testing::_)).WillByDefault(::testing::Return(paNoError));
+    ON_CALL(mock_pa, stopStream(::testing::_)).WillByDefault(::testing::Return(paNoError));
+    ON_CALL(mock_pa, abortStream(::testing::_)).WillByDefault(::testing::Return(paNoError));
+    ON_CALL(mock_pa, closeStream(::testing::_)).WillByDefault(::testing::Return(paNoError));
+    ON_CALL(mock_pa, getStreamInfo(::testing::_)).WillByDefault(::testing::Return(nullptr));
+    ON_CALL(mock_pa, isFormatSupported(::testing::_, ::testing::_, ::testing::_)).WillByDefault(::testing::Return(paNoError));
+
+    auto attrs = viam::sdk::ProtoStruct{};
+    attrs["device_name"] = std::string("Load Harness Device");
+    attrs["sample_rate"] = static_cast<double>(REQUESTED_SAMPLE_RATE);
+    attrs["num_channels"] = static_cast<double>(NUM_CHANNELS);
+    viam::sdk::ResourceConfig config("rdk:component:audioin", "", "load_harness_mic", attrs, "", microphone::Microphone::model,
+                                     viam::sdk::LinkConfig{}, viam::sdk::log_level::info);
+
+    microphone::Microphone mic(viam::sdk::Dependencies{}, config, &mock_pa);
+
+    // Anchor the capture context's timestamp base the way the first real
+    // callback would, then start the synthetic source
+    std::shared_ptr<audio::InputStreamContext> ctx;
+    {
+        std::lock_guard<std::mutex> lock(mic.stream_ctx_mu_);
+        ctx = mic.audio_context_;
+    }
+    ctx->first_sample_adc_time = 0.0;
+    ctx->stream_start_time = std::chrono::system_clock::now();
+    ctx->first_callback_captured.store(true);
+
+    std::atomic<bool> stop_source{false};
+    std::thread source([&]() { run_synthetic_source(ctx, stop_source); });
+
+    const std::vector<std::string> codecs = {viam::sdk::audio_codecs::PCM_16, viam::sdk::audio_codecs::PCM_32_FLOAT,
+                                             viam::sdk::audio_codecs::MP3, audio::codec::OPUS_CODEC_NAME};
+
+    std::printf("load_harness: %d clients, %.1fs run, device %d Hz -> requested %d Hz, codecs pcm16/pcm32_float/mp3/opus\n", num_clients,
+                run_seconds, DEVICE_SAMPLE_RATE, REQUESTED_SAMPLE_RATE);
+
+    std::vector<ClientResult> results(num_clients);
+    for (int i = 0; i < num_clients; i++) {
+        results[i].codec = codecs[i % codecs.size()];
+        // Reserve generously up front so latency recording does not skew the
+        // allocation count with vector growth mid-run
+        results[i].latencies_ns.reserve(static_cast<std::size_t>(run_seconds * 50) + 64);
+    }
+
+    rusage usage_start{};
+    getrusage(RUSAGE_SELF, &usage_start);
+    const uint64_t allocs_start = g_alloc_count.load(std::memory_order_relaxed);
+    const auto wall_start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> clients;
+    for (int i = 0; i < num_clients; i++) {
+        clients.emplace_back([&, i]() {
+            ClientResult& result = results[i];
+            auto handler = [&result](viam::sdk::AudioIn::audio_chunk&& chunk) {
+                const int64_t now_ns =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                result.latencies_ns.push_back(now_ns - chunk.end_timestamp_ns.count());
+                result.chunks++;
+                result.bytes += chunk.audio_data.size();
+                return true;
+            };
+            try {
+                mic.get_audio(result.codec, handler, run_seconds, 0, viam::sdk::ProtoStruct{});
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "client %d (%s) failed: %s\n", i, result.codec.c_str(), e.what());
+            }
+        });
+    }
+
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    const uint64_t allocs = g_alloc_count.load(std::memory_order_relaxed) - allocs_start;
+    rusage usage_end{};
+    getrusage(RUSAGE_SELF, &usage_end);
+    const double cpu_seconds = rusage_cpu_seconds(usage_end) - rusage_cpu_seconds(usage_start);
+
+    stop_source.store(true);
+    source.join();
+
+    // Aggregate latency distributions per codec across clients
+    for (const auto& codec : codecs) {
+        std::vector<int64_t> all;
+        uint64_t chunks = 0;
+        uint64_t bytes = 0;
+        for (const auto& result : results) {
+            if (result.codec != codec) continue;
+            all.insert(all.end(), result.latencies_ns.begin(), result.latencies_ns.end());
+            chunks += result.chunks;
+            bytes += result.bytes;
+        }
+        std::sort(all.begin(), all.end());
+        std::printf("%-12s chunks=%llu bytes=%llu  latency ms p50=%.2f p90=%.2f p99=%.2f max=%.2f\n", codec.c_str(),
+                    static_cast<unsigned long long>(chunks), static_cast<unsigned long long>(bytes), percentile(all, 50) / 1e6,
+                    percentile(all, 90) / 1e6, percentile(all, 99) / 1e6, all.empty() ? 0.0 : all.back() / 1e6);
+    }
+
+    std::printf("cpu=%.2fs (%.1f%% of %.1fs wall)  heap allocations=%llu\n", cpu_seconds, 100.0 * cpu_seconds / wall_seconds,
+                wall_seconds, static_cast<unsigned long long>(allocs));
+
+    const auto stats = mic.do_command(viam::sdk::ProtoStruct{{"stats", true}});
+    const double* overflows = stats.count("input_overflows") ? stats.at("input_overflows").get<double>() : nullptr;
+    const double* restarts = stats.count("restarts") ? stats.at("restarts").get<double>() : nullptr;
+    std::printf("mic stats: input_overflows=%.0f restarts=%.0f\n", overflows ? *overflows : 0.0, restarts ? *restarts : 0.0);
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <viam/sdk/common/audio.hpp>
 #include "microphone.hpp"
 #include "test_utils.hpp"
+#include <limits>
 #include <thread>
 
 using namespace viam::sdk;
@@ -238,6 +239,31 @@ TEST_F(MicrophoneTest, DoCommandReturnsEmptyStruct) {
 }
 
 
+TEST_F(MicrophoneTest, DoCommandStatsReportsRingAndCounters) {
+    microphone::Microphone mic(test_deps_, *test_config_, mock_pa_.get());
+
+    ProtoStruct command{{"stats", true}};
+    auto result = mic.do_command(command);
+
+    ASSERT_TRUE(result.count("active_streams"));
+    EXPECT_EQ(*result.at("active_streams").get<double>(), 0.0);
+    ASSERT_TRUE(result.count("restarts"));
+    EXPECT_EQ(*result.at("restarts").get<double>(), 0.0);
+
+    // A capture context exists after construction, so ring stats are present
+    ASSERT_TRUE(result.count("ring_capacity"));
+    EXPECT_GT(*result.at("ring_capacity").get<double>(), 0.0);
+    ASSERT_TRUE(result.count("ring_fill"));
+    ASSERT_TRUE(result.count("input_overflows"));
+    ASSERT_TRUE(result.count("callback_intervals"));
+
+    // Bucket labels from the fixed histogram bounds
+    auto intervals = *result.at("callback_intervals").get<ProtoStruct>();
+    EXPECT_TRUE(intervals.count("le_1ms"));
+    EXPECT_TRUE(intervals.count("gt_500ms"));
+}
+
+
 TEST_F(MicrophoneTest, GetPropertiesReturnsCorrectValues) {
     int sample_rate = 48000;
     int num_channels = 2;
@@ -627,6 +653,34 @@ TEST_F(MicrophoneTest, ReconfigureChangesAudioContext) {
     EXPECT_EQ(initial_context->get_write_position(), 100);
 }
 
+TEST_F(MicrophoneTest, ReconfigureStreamIrrelevantChangeKeepsStream) {
+    auto config = createConfig(testDeviceName, 44100, 2, 0.0, 50);
+    expectSuccessfulStreamCreation();
+    microphone::Microphone mic(test_deps_, config, mock_pa_.get());
+
+    auto initial_context = mic.audio_context_;
+    ASSERT_NE(initial_context, nullptr);
+    for (int i = 0; i < 100; i++) {
+        initial_context->write_sample(static_cast<int16_t>(i));
+    }
+
+    // Only the throttle changed - the stream must not be touched
+    EXPECT_CALL(*mock_pa_, stopStream(::testing::_)).Times(0);
+    EXPECT_CALL(*mock_pa_, closeStream(::testing::_)).Times(0);
+    EXPECT_CALL(*mock_pa_, openStream(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_,
+                                      ::testing::_))
+        .Times(0);
+
+    auto new_config = createConfig(testDeviceName, 44100, 2, 0.0, 200);
+    EXPECT_NO_THROW(mic.reconfigure(test_deps_, new_config));
+
+    EXPECT_EQ(mic.historical_throttle_ms_, 200);
+
+    // Same context, ring history intact
+    EXPECT_EQ(mic.audio_context_, initial_context);
+    EXPECT_EQ(initial_context->get_write_position(), 100);
+}
+
 TEST_F(MicrophoneTest, MultipleConcurrentGetAudioCalls) {
     auto config = createConfig(testDeviceName, 44100, 2);
     microphone::Microphone mic(test_deps_, config, mock_pa_.get());
@@ -932,6 +986,241 @@ TEST_F(MicrophoneTest, GetAudioSucceedsWithValidTimestamp) {
     EXPECT_TRUE(called);
 }
 
+TEST_F(MicrophoneTest, ValidateWithInvalidConfig_BufferDurationNotPositive) {
+    auto attrs = ProtoStruct{};
+    attrs["buffer_duration_seconds"] = 0.0;
+    ResourceConfig config(
+        "rdk:component:audioin", "", "test_microphone", attrs, "",
+        microphone::Microphone::model, LinkConfig{}, log_level::info
+    );
+
+    EXPECT_THROW(microphone::Microphone::validate(config), std::invalid_argument);
+}
+
+TEST_F(MicrophoneTest, BufferDurationFromConfigSizesCaptureRing) {
+    auto attrs = ProtoStruct{};
+    attrs["device_name"] = std::string(testDeviceName);
+    attrs["sample_rate"] = 48000.0;
+    attrs["num_channels"] = 2.0;
+    attrs["buffer_duration_seconds"] = 5.0;
+    ResourceConfig config(
+        "rdk:component:audioin", "", "test_microphone", attrs, "",
+        microphone::Microphone::model, LinkConfig{}, log_level::info
+    );
+    expectSuccessfulStreamCreation();
+    microphone::Microphone mic(test_deps_, config, mock_pa_.get());
+
+    std::lock_guard<std::mutex> lock(mic.stream_ctx_mu_);
+    ASSERT_NE(mic.audio_context_, nullptr);
+    EXPECT_EQ(mic.audio_context_->buffer_capacity, 48000 * 2 * 5);
+    // The standby restart context matches the configured history
+    ASSERT_NE(mic.standby_context_, nullptr);
+    EXPECT_EQ(mic.standby_context_->buffer_capacity, 48000 * 2 * 5);
+}
+
+TEST_F(MicrophoneTest, StandbyContextPrewarmedAfterConstruction) {
+    auto config = createConfig(testDeviceName, 48000, 2);
+    expectSuccessfulStreamCreation();
+    microphone::Microphone mic(test_deps_, config, mock_pa_.get());
+
+    std::lock_guard<std::mutex> lock(mic.stream_ctx_mu_);
+    ASSERT_NE(mic.standby_context_, nullptr);
+    EXPECT_NE(mic.standby_context_, mic.audio_context_);
+    EXPECT_EQ(mic.standby_context_->info.sample_rate_hz, 48000);
+    EXPECT_EQ(mic.standby_context_->info.num_channels, 2);
+}
+
+TEST_F(MicrophoneTest, RetiredContextServesOnlyTimestampsBeforeLiveStart) {
+    auto config = createConfig(testDeviceName, 48000, 1);
+    expectSuccessfulStreamCreation();
+    microphone::Microphone mic(test_deps_, config, mock_pa_.get());
+
+    // Live context started "now"; retire a context whose history covers the
+    // minute before it, as a stall restart would
+    auto live_ctx = createTestContext(mic, 48000);
+    const auto live_start_ns =
+        std::chrono::time_point_cast<std::chrono::nanoseconds>(live_ctx->stream_start_time).time_since_epoch().count();
+
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, 48000, 1};
+    auto retired = std::make_shared<audio::InputStreamContext>(info, 10);
+    retired->stream_start_time = live_ctx->stream_start_time - std::chrono::seconds(60);
+    retired->first_callback_captured.store(true);
+    {
+        std::lock_guard<std::mutex> lock(mic.stream_ctx_mu_);
+        mic.retired_context_ = retired;
+        mic.retired_at_ = std::chrono::steady_clock::now();
+    }
+
+    // A timestamp before the live stream started resolves to the retired ring
+    EXPECT_EQ(mic.retired_context_covering(live_start_ns - 1000000000), retired);
+    // Timestamps the live context can serve stay on the live context
+    EXPECT_EQ(mic.retired_context_covering(live_start_ns + 1000000000), nullptr);
+
+    // Once the retention window has elapsed the frozen ring is dropped
+    {
+        std::lock_guard<std::mutex> lock(mic.stream_ctx_mu_);
+        mic.retired_at_ = std::chrono::steady_clock::now() - std::chrono::seconds(audio::BUFFER_DURATION_SECONDS + 1);
+    }
+    EXPECT_EQ(mic.retired_context_covering(live_start_ns - 1000000000), nullptr);
+    std::lock_guard<std::mutex> lock(mic.stream_ctx_mu_);
+    EXPECT_EQ(mic.retired_context_, nullptr);
+}
+
+
+TEST(SilenceGateTest, DisabledGateDeliversEverything) {
+    microphone::SilenceGate gate;  // default: disabled
+
+    std::vector<int16_t> silence(100, 0);
+    EXPECT_TRUE(gate.should_deliver(silence.data(), silence.size()));
+    EXPECT_TRUE(gate.should_deliver(0.0));
+}
+
+TEST(SilenceGateTest, SuppressesSilenceAndResumesOnLoudAudio) {
+    // No hang time so suppression kicks in immediately after the last loud chunk
+    microphone::SilenceGate gate(true, 0.01, 0);
+
+    std::vector<int16_t> silence(100, 0);
+    std::vector<int16_t> loud(100, 16000);
+
+    // Silent from the start - nothing loud seen yet, so suppress
+    EXPECT_FALSE(gate.should_deliver(silence.data(), silence.size()));
+
+    // Loud audio always delivers
+    EXPECT_TRUE(gate.should_deliver(loud.data(), loud.size()));
+
+    // Back to silence with zero hang - suppressed again
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_FALSE(gate.should_deliver(silence.data(), silence.size()));
+}
+
+TEST(SilenceGateTest, HangTimeKeepsDeliveringAfterLoudChunk) {
+    microphone::SilenceGate gate(true, 0.01, 10000);
+
+    std::vector<int16_t> silence(100, 0);
+    std::vector<int16_t> loud(100, 16000);
+
+    EXPECT_TRUE(gate.should_deliver(loud.data(), loud.size()));
+    // Within the hang window, quiet chunks still deliver
+    EXPECT_TRUE(gate.should_deliver(silence.data(), silence.size()));
+}
+
+TEST(ComputeRmsTest, ReturnsExpectedLevels) {
+    EXPECT_DOUBLE_EQ(audio::codec::compute_rms(nullptr, 100), 0.0);
+
+    std::vector<int16_t> silence(100, 0);
+    EXPECT_DOUBLE_EQ(audio::codec::compute_rms(silence.data(), silence.size()), 0.0);
+
+    // A constant signal's RMS equals its amplitude
+    std::vector<int16_t> constant(100, 16384);
+    EXPECT_NEAR(audio::codec::compute_rms(constant.data(), constant.size()), 0.5, 0.001);
+}
+
+TEST(CaptureFormatConvertTest, Int32ToPcm16TakesHighWord) {
+    const int32_t input[] = {0, 0x7FFF0000, static_cast<int32_t>(0x80000000), 0x00010000, -0x00010000};
+    int16_t output[5] = {};
+    audio::codec::convert_int32_to_pcm16(input, output, 5);
+
+    EXPECT_EQ(output[0], 0);
+    EXPECT_EQ(output[1], 0x7FFF);
+    EXPECT_EQ(output[2], std::numeric_limits<int16_t>::min());
+    EXPECT_EQ(output[3], 1);
+    EXPECT_EQ(output[4], -1);
+}
+
+TEST(CaptureFormatConvertTest, Int24ToPcm16ReadsPackedLittleEndian) {
+    // Three packed little-endian 24-bit samples: 0x7FFF00, 0x800000 (min), 0x000100
+    const uint8_t input[] = {0x00, 0xFF, 0x7F, 0x00, 0x00, 0x80, 0x00, 0x01, 0x00};
+    int16_t output[3] = {};
+    audio::codec::convert_int24_to_pcm16(input, output, 3);
+
+    EXPECT_EQ(output[0], 0x7FFF);
+    EXPECT_EQ(output[1], std::numeric_limits<int16_t>::min());
+    EXPECT_EQ(output[2], 1);
+}
+
+TEST(CaptureFormatConvertTest, Float32ToPcm16ScalesAndClamps) {
+    const float input[] = {0.0f, 1.0f, -1.0f, 0.5f, 2.0f, -2.0f};
+    int16_t output[6] = {};
+    audio::codec::convert_float32_to_pcm16_samples(input, output, 6);
+
+    EXPECT_EQ(output[0], 0);
+    EXPECT_EQ(output[1], 32767);
+    EXPECT_EQ(output[2], -32767);
+    EXPECT_NEAR(output[3], 16384, 1);
+    EXPECT_EQ(output[4], 32767);   // clamped
+    EXPECT_EQ(output[5], -32768);  // clamped
+}
+
+TEST(CalculateCatchupReadSize, ReturnsOneChunkWhenBarelyBehind) {
+    // Less than one chunk available still reads a whole chunk
+    EXPECT_EQ(microphone::calculate_catchup_read_size(1000, 4410, 44100, 44100, 2, 1 << 20), 4410);
+}
+
+TEST(CalculateCatchupReadSize, CoalescesBacklogIntoWholeChunks) {
+    // 10.5 chunks of backlog rounds down to 10 whole chunks
+    EXPECT_EQ(microphone::calculate_catchup_read_size(4410 * 10 + 2205, 4410, 44100, 44100, 2, 1 << 20), 4410 * 10);
+}
+
+TEST(CalculateCatchupReadSize, ByteCapBoundsTheRead) {
+    // 88200-byte cap with 2-byte samples allows 44100 samples = 10 chunks,
+    // even with a much larger backlog
+    EXPECT_EQ(microphone::calculate_catchup_read_size(4410 * 100, 4410, 44100, 44100, 2, 88200), 4410 * 10);
+
+    // 4-byte output samples (pcm32 / float32) halve the sample budget
+    EXPECT_EQ(microphone::calculate_catchup_read_size(4410 * 100, 4410, 44100, 44100, 4, 88200), 4410 * 5);
+}
+
+TEST(CalculateCatchupReadSize, ScalesCapThroughResamplingRatio) {
+    // Downsampling 48k -> 16k: each output sample consumes 3 device samples,
+    // so the device-side budget is 3x the output budget
+    const int chunk = 4800;
+    const int max_bytes = 16000 * 2;  // one second of 16kHz output
+    EXPECT_EQ(microphone::calculate_catchup_read_size(4800 * 100, chunk, 48000, 16000, 2, max_bytes), 48000);
+}
+
+TEST(SharedMP3EncoderTest, ConcurrentReadersGetIdenticalChunks) {
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, 44100, 1};
+    auto ctx = std::make_shared<audio::InputStreamContext>(info, 10);
+    ctx->stream_start_time = std::chrono::system_clock::now();
+    ctx->first_callback_captured.store(true);
+
+    microphone::SharedMP3Encoder encoder(ctx, 44100, 44100, 1);
+    EXPECT_EQ(encoder.next_sequence(), 0);
+
+    // Write enough audio for several frame-aligned chunks
+    std::vector<int16_t> samples(44100);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = static_cast<int16_t>(i % 1000);
+    }
+    ctx->write_samples(samples.data(), samples.size());
+    ctx->notify_samples_written();
+
+    // Two readers at the same cursor receive byte-identical encoded chunks -
+    // the stream is encoded once, not per reader
+    uint64_t cursor1 = 0;
+    uint64_t cursor2 = 0;
+    microphone::EncodedMP3Chunk chunk1;
+    microphone::EncodedMP3Chunk chunk2;
+    ASSERT_TRUE(encoder.get_chunk(cursor1, chunk1, std::chrono::milliseconds(500)));
+    ASSERT_TRUE(encoder.get_chunk(cursor2, chunk2, std::chrono::milliseconds(500)));
+
+    EXPECT_EQ(chunk1.sequence, chunk2.sequence);
+    EXPECT_EQ(chunk1.start_position, chunk2.start_position);
+    EXPECT_EQ(chunk1.end_position, chunk2.end_position);
+    EXPECT_EQ(chunk1.data, chunk2.data);
+    EXPECT_EQ(encoder.next_sequence(), 1);
+}
+
+TEST(SharedMP3EncoderTest, GetChunkTimesOutWithoutAudio) {
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, 44100, 1};
+    auto ctx = std::make_shared<audio::InputStreamContext>(info, 10);
+
+    microphone::SharedMP3Encoder encoder(ctx, 44100, 44100, 1);
+
+    uint64_t cursor = 0;
+    microphone::EncodedMP3Chunk chunk;
+    EXPECT_FALSE(encoder.get_chunk(cursor, chunk, std::chrono::milliseconds(20)));
+}
 
 TEST(GetInitialReadPosition, ZeroTimestampReturnsCurrentWritePosition) {
     viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, 48000, 2};
@@ -1231,6 +1520,65 @@ TEST_F(MicrophoneTest, CodecConversion_MP3_Stereo) {
     EXPECT_EQ(chunks_received, 5);
 }
 
+TEST_F(MicrophoneTest, CodecConversion_OpusWithResampling) {
+    // Requested 48000 (a valid Opus rate) on a device that only runs natively
+    // at 44100 - setupStreamFromConfig falls back to the device rate and the
+    // session resamples. The resampler's per-chunk output count is not
+    // aligned to whole 20ms Opus frames, so this exercises the remainder
+    // carry between iterations.
+    ON_CALL(*mock_pa_, isFormatSupported(::testing::_, ::testing::_, 48000.0))
+        .WillByDefault(::testing::Return(paSampleFormatNotSupported));
+
+    auto config = createConfig(testDeviceName, 48000, 1);
+    microphone::Microphone mic(test_deps_, config, mock_pa_.get());
+
+    EXPECT_EQ(mic.stream_params_.sample_rate, test_utils::DEFAULT_DEVICE_SAMPLE_RATE);
+    EXPECT_EQ(mic.requested_sample_rate_, 48000);
+
+    auto ctx = createTestContext(mic);
+
+    int chunks_received = 0;
+    std::vector<uint8_t> encoded;
+
+    auto handler = [&](viam::sdk::AudioIn::audio_chunk&& chunk) {
+        chunks_received++;
+        EXPECT_EQ(chunk.info.codec, audio::codec::OPUS_CODEC_NAME);
+        EXPECT_EQ(chunk.info.sample_rate_hz, 48000);
+        encoded.insert(encoded.end(), chunk.audio_data.begin(), chunk.audio_data.end());
+        return chunks_received < 5;
+    };
+
+    // Write samples continuously in background thread
+    std::atomic<bool> stop_writing{false};
+    std::thread writer([&]() {
+        for (int i = 0; i < 500000 && !stop_writing.load(); i++) {
+            ctx->write_sample(static_cast<int16_t>(i % 1000));
+        }
+    });
+
+    std::thread reader([&]() {
+        EXPECT_NO_THROW(mic.get_audio(audio::codec::OPUS_CODEC_NAME, handler, 2.0, 0, ProtoStruct{}));
+    });
+
+    reader.join();
+    stop_writing = true;
+    writer.join();
+
+    EXPECT_EQ(chunks_received, 5);
+
+    // The delivered bytes must be a clean sequence of length-prefixed Opus
+    // packets (torn framing would mean a partial frame was encoded)
+    size_t offset = 0;
+    size_t packets = 0;
+    while (offset + 2 <= encoded.size()) {
+        const size_t packet_bytes = encoded[offset] | (encoded[offset + 1] << 8);
+        offset += 2 + packet_bytes;
+        packets++;
+    }
+    EXPECT_EQ(offset, encoded.size());
+    EXPECT_GT(packets, 0);
+}
+
 TEST_F(MicrophoneTest, HistoricalDataRespectsDuration) {
     auto config = createConfig("", 48000, 2);
     expectSuccessfulStreamCreation();
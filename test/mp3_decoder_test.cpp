@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <cstring>
 #include <viam/sdk/common/instance.hpp>
 #include "mp3_decoder.hpp"
 #include "mp3_encoder.hpp"
@@ -124,6 +125,89 @@ TEST_F(MP3DecoderTest, DecodeInvalidMP3Data) {
     );
 }
 
+TEST_F(MP3DecoderTest, StreamingDecodeMatchesWholeFileDecode) {
+    const int sample_rate = 48000;
+    const int num_channels = 2;
+
+    auto test_samples = create_test_samples(1152 * 4 * 2);  // 4 frames, stereo
+    auto encoded_data = encode_to_mp3(test_samples, sample_rate, num_channels);
+
+    // Decode frame by frame, accumulating the delivered samples
+    std::vector<uint8_t> streamed_data;
+    int frames = 0;
+    ASSERT_NO_THROW({
+        frames = decode_mp3_streaming(*decoder_ctx_, encoded_data, [&](const int16_t* samples, int sample_count) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(samples);
+            streamed_data.insert(streamed_data.end(), bytes, bytes + sample_count * sizeof(int16_t));
+            return true;
+        });
+    });
+
+    EXPECT_GT(frames, 1);
+    EXPECT_EQ(decoder_ctx_->sample_rate, sample_rate);
+    EXPECT_EQ(decoder_ctx_->num_channels, num_channels);
+
+    // Whole-file decode through a fresh decoder must produce identical output
+    MP3DecoderContext whole_file_ctx;
+    std::vector<uint8_t> decoded_data;
+    decode_mp3_to_pcm16(whole_file_ctx, encoded_data, decoded_data);
+    EXPECT_EQ(streamed_data, decoded_data);
+}
+
+TEST_F(MP3DecoderTest, EstimateFromCBRHeader) {
+    // MPEG1 Layer III, 128 kbps, 44100 Hz, stereo - no Xing tag, so the
+    // estimate comes from the bitrate-derived duration
+    std::vector<uint8_t> data(1000, 0);
+    data[0] = 0xFF;
+    data[1] = 0xFB;
+    data[2] = 0x90;
+    data[3] = 0x00;
+
+    // 1000 bytes at 128 kbps = 62.5ms = 2 full frames at 1152 samples, +1
+    // frame of rounding slack, stereo pcm16
+    const size_t expected_frames = static_cast<size_t>(1000.0 * 8.0 / 128000.0 * 44100.0 / 1152.0) + 1;
+    EXPECT_EQ(estimate_mp3_decoded_bytes(data.data(), data.size()), expected_frames * 1152 * 2 * sizeof(int16_t));
+}
+
+TEST_F(MP3DecoderTest, EstimateFromXingFrameCount) {
+    // Same header, but with a Xing tag after the 32-byte stereo side info
+    // carrying an exact frame count of 100
+    std::vector<uint8_t> data(256, 0);
+    data[0] = 0xFF;
+    data[1] = 0xFB;
+    data[2] = 0x90;
+    data[3] = 0x00;
+    const size_t tag_offset = 4 + 32;
+    std::memcpy(data.data() + tag_offset, "Xing", 4);
+    data[tag_offset + 7] = 0x01;   // flags: frames field present
+    data[tag_offset + 11] = 100;   // frame count (big-endian)
+
+    EXPECT_EQ(estimate_mp3_decoded_bytes(data.data(), data.size()), 100u * 1152 * 2 * sizeof(int16_t));
+}
+
+TEST_F(MP3DecoderTest, EstimateReturnsZeroForUnparseableData) {
+    std::vector<uint8_t> no_sync(64, 0);
+    EXPECT_EQ(estimate_mp3_decoded_bytes(no_sync.data(), no_sync.size()), 0u);
+    EXPECT_EQ(estimate_mp3_decoded_bytes(nullptr, 0), 0u);
+}
+
+TEST_F(MP3DecoderTest, StreamingDecodeStopsWhenCallbackReturnsFalse) {
+    const int sample_rate = 48000;
+    const int num_channels = 1;
+
+    auto test_samples = create_test_samples(1152 * 4);
+    auto encoded_data = encode_to_mp3(test_samples, sample_rate, num_channels);
+
+    int frames_delivered = 0;
+    const int frames = decode_mp3_streaming(*decoder_ctx_, encoded_data, [&](const int16_t*, int) {
+        frames_delivered++;
+        return false;  // stop after the first frame
+    });
+
+    EXPECT_EQ(frames_delivered, 1);
+    EXPECT_EQ(frames, 1);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     ::testing::AddGlobalTestEnvironment(new test_utils::AudioTestEnvironment);
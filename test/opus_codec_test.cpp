@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <viam/sdk/common/instance.hpp>
+#include "opus_decoder.hpp"
+#include "opus_encoder.hpp"
+#include "test_utils.hpp"
+
+using namespace speaker;
+using namespace microphone;
+
+class OpusCodecTest : public ::testing::Test {
+protected:
+    OpusEncoderContext encoder_ctx_;
+    OpusDecoderContext decoder_ctx_;
+
+    void TearDown() override {
+        cleanup_opus_encoder(encoder_ctx_);
+    }
+
+    // Helper to create a 440Hz sine so the encoder has real signal to work on
+    std::vector<int16_t> create_test_samples(int num_samples, int sample_rate) {
+        std::vector<int16_t> samples(num_samples);
+        for (int i = 0; i < num_samples; i++) {
+            samples[i] = static_cast<int16_t>(16000.0 * std::sin(2.0 * M_PI * 440.0 * i / sample_rate));
+        }
+        return samples;
+    }
+};
+
+TEST_F(OpusCodecTest, EncodeDecodeRoundTrip) {
+    const int sample_rate = 48000;
+    const int num_channels = 1;
+    initialize_opus_encoder(encoder_ctx_, sample_rate, num_channels, OPUS_DEFAULT_BITRATE, OPUS_DEFAULT_COMPLEXITY);
+    ASSERT_GT(encoder_ctx_.frame_size, 0);
+
+    // Four whole 20ms frames
+    const int num_samples = encoder_ctx_.frame_size * num_channels * 4;
+    std::vector<int16_t> samples = create_test_samples(num_samples, sample_rate);
+
+    std::vector<uint8_t> encoded;
+    encode_samples_to_opus(encoder_ctx_, samples.data(), samples.size(), 0, encoded);
+    ASSERT_FALSE(encoded.empty());
+    // Opus at 24kbps should compress far below the pcm16 source size
+    EXPECT_LT(encoded.size(), samples.size() * sizeof(int16_t) / 4);
+
+    std::vector<uint8_t> decoded;
+    decode_opus_to_pcm16(decoder_ctx_, encoded, sample_rate, num_channels, decoded);
+
+    // One decoded frame per encoded frame, at full frame size
+    EXPECT_EQ(decoded.size(), num_samples * sizeof(int16_t));
+}
+
+TEST_F(OpusCodecTest, EncodeRejectsUnsupportedSampleRate) {
+    EXPECT_THROW(initialize_opus_encoder(encoder_ctx_, 44100, 1, OPUS_DEFAULT_BITRATE, OPUS_DEFAULT_COMPLEXITY), std::invalid_argument);
+}
+
+TEST_F(OpusCodecTest, EncodeRejectsUnalignedChunk) {
+    initialize_opus_encoder(encoder_ctx_, 48000, 1, OPUS_DEFAULT_BITRATE, OPUS_DEFAULT_COMPLEXITY);
+
+    std::vector<int16_t> samples = create_test_samples(encoder_ctx_.frame_size + 1, 48000);
+    std::vector<uint8_t> encoded;
+    EXPECT_THROW(encode_samples_to_opus(encoder_ctx_, samples.data(), samples.size(), 0, encoded), std::invalid_argument);
+}
+
+TEST_F(OpusCodecTest, DecodeRejectsMalformedFraming) {
+    // Length prefix claims more bytes than the payload holds
+    std::vector<uint8_t> malformed = {0xFF, 0x00, 0x01, 0x02};
+    std::vector<uint8_t> decoded;
+    EXPECT_THROW(decode_opus_to_pcm16(decoder_ctx_, malformed, 48000, 1, decoded), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new test_utils::AudioTestEnvironment);
+    return RUN_ALL_TESTS();
+}
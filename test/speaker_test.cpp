@@ -2,6 +2,7 @@
 #include <gmock/gmock.h>
 #include <viam/sdk/config/resource.hpp>
 #include <cmath>
+#include <fstream>
 #include "speaker.hpp"
 #include "test_utils.hpp"
 #include "audio_codec.hpp"
@@ -906,6 +907,385 @@ TEST_F(SpeakerTest, CodecConversion_ChannelMismatch) {
   }
 
 
+TEST_F(SpeakerTest, DecodedCacheServesRepeatPlays) {
+    int speaker_sample_rate = 48000;
+    int num_channels = 1;
+
+    auto attributes = ProtoStruct{};
+    attributes["sample_rate"] = static_cast<double>(speaker_sample_rate);
+    attributes["num_channels"] = static_cast<double>(num_channels);
+
+    ResourceConfig config(
+        "rdk:component:audioout", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    // 44100 Hz audio forces the resample path, which is cacheable
+    int audio_sample_rate = 44100;
+    int num_samples = 4410;
+    std::vector<int16_t> test_samples(num_samples);
+    for (int i = 0; i < num_samples; i++) {
+        test_samples[i] = static_cast<int16_t>(i % 1000);
+    }
+    std::vector<uint8_t> audio_data(num_samples * sizeof(int16_t));
+    std::memcpy(audio_data.data(), test_samples.data(), audio_data.size());
+
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, audio_sample_rate, num_channels};
+    ProtoStruct extra{};
+
+    int expected_resampled_samples = (num_samples * speaker_sample_rate) / audio_sample_rate;
+    speaker.audio_context_->playback_position.store(2 * expected_resampled_samples);
+
+    speaker.play(audio_data, info, extra);
+    EXPECT_EQ(speaker.decoded_cache_bytes_used_, expected_resampled_samples * sizeof(int16_t));
+    const uint64_t write_pos_after_first = speaker.audio_context_->get_write_position();
+    EXPECT_EQ(write_pos_after_first, expected_resampled_samples);
+
+    // Second play of the same bytes is served from the cache and writes the
+    // identical resampled samples again
+    speaker.play(audio_data, info, extra);
+    EXPECT_EQ(speaker.audio_context_->get_write_position(), 2 * write_pos_after_first);
+    EXPECT_EQ(speaker.decoded_cache_bytes_used_, expected_resampled_samples * sizeof(int16_t));
+}
+
+TEST_F(SpeakerTest, DecodedCacheDisabledWithZeroBudget) {
+    int speaker_sample_rate = 48000;
+    int num_channels = 1;
+
+    auto attributes = ProtoStruct{};
+    attributes["sample_rate"] = static_cast<double>(speaker_sample_rate);
+    attributes["num_channels"] = static_cast<double>(num_channels);
+    attributes["decoded_cache_bytes"] = 0.0;
+
+    ResourceConfig config(
+        "rdk:component:audioout", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    int audio_sample_rate = 44100;
+    int num_samples = 4410;
+    std::vector<uint8_t> audio_data(num_samples * sizeof(int16_t));
+
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, audio_sample_rate, num_channels};
+    ProtoStruct extra{};
+
+    int expected_resampled_samples = (num_samples * speaker_sample_rate) / audio_sample_rate;
+    speaker.audio_context_->playback_position.store(expected_resampled_samples);
+
+    speaker.play(audio_data, info, extra);
+    EXPECT_EQ(speaker.decoded_cache_bytes_used_, 0u);
+    EXPECT_TRUE(speaker.decoded_cache_lru_.empty());
+}
+
+TEST_F(SpeakerTest, Play_MP3StreamsIntoRing) {
+    int sample_rate = 48000;
+    int num_channels = 1;
+
+    auto attributes = ProtoStruct{};
+    attributes["sample_rate"] = static_cast<double>(sample_rate);
+    attributes["num_channels"] = static_cast<double>(num_channels);
+
+    ResourceConfig config(
+        "rdk:component:audioout", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    // Encode a few frames of test audio to MP3
+    int num_samples = 1152 * 4;
+    std::vector<int16_t> test_samples(num_samples);
+    for (int i = 0; i < num_samples; i++) {
+        test_samples[i] = static_cast<int16_t>((i % 1000) * 32);
+    }
+    microphone::MP3EncoderContext encoder_ctx;
+    microphone::initialize_mp3_encoder(encoder_ctx, sample_rate, num_channels);
+    std::vector<uint8_t> encoded_data;
+    microphone::encode_samples_to_mp3(encoder_ctx, test_samples.data(), num_samples, 0, encoded_data);
+    microphone::flush_mp3_encoder(encoder_ctx, encoded_data);
+    microphone::cleanup_mp3_encoder(encoder_ctx);
+
+    // Stand in for the PortAudio callback: keep the playback position caught
+    // up with the write position so the streaming path never backpressures
+    // and the completion wait finishes
+    std::atomic<bool> consumer_done{false};
+    std::thread consumer([&] {
+        while (!consumer_done.load()) {
+            speaker.audio_context_->playback_position.store(speaker.audio_context_->get_write_position());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::MP3, sample_rate, num_channels};
+    ProtoStruct extra{};
+
+    EXPECT_NO_THROW({
+        speaker.play(encoded_data, info, extra);
+    });
+
+    consumer_done.store(true);
+    consumer.join();
+
+    // The decoded frames were written into the ring as they were produced
+    EXPECT_GT(speaker.audio_context_->get_write_position(), 0u);
+}
+
+// Helper to build a minimal pcm16 WAV file in memory
+static std::vector<uint8_t> make_wav_pcm16(const std::vector<int16_t>& samples, int sample_rate, int num_channels) {
+    std::vector<uint8_t> wav;
+    auto put_bytes = [&](const char* s) { wav.insert(wav.end(), s, s + 4); };
+    auto put_le32 = [&](uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            wav.push_back(static_cast<uint8_t>((v >> (8 * i)) & 0xFF));
+        }
+    };
+    auto put_le16 = [&](uint16_t v) {
+        wav.push_back(static_cast<uint8_t>(v & 0xFF));
+        wav.push_back(static_cast<uint8_t>(v >> 8));
+    };
+
+    const uint32_t data_bytes = samples.size() * sizeof(int16_t);
+    put_bytes("RIFF");
+    put_le32(36 + data_bytes);
+    put_bytes("WAVE");
+    put_bytes("fmt ");
+    put_le32(16);
+    put_le16(1);  // PCM
+    put_le16(num_channels);
+    put_le32(sample_rate);
+    put_le32(sample_rate * num_channels * sizeof(int16_t));
+    put_le16(num_channels * sizeof(int16_t));
+    put_le16(16);  // bits per sample
+    put_bytes("data");
+    put_le32(data_bytes);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(samples.data());
+    wav.insert(wav.end(), bytes, bytes + data_bytes);
+    return wav;
+}
+
+TEST_F(SpeakerTest, PlayFileStreamsWavFromAssetDir) {
+    int sample_rate = 48000;
+    int num_channels = 1;
+
+    auto attributes = ProtoStruct{};
+    attributes["sample_rate"] = static_cast<double>(sample_rate);
+    attributes["num_channels"] = static_cast<double>(num_channels);
+    attributes["asset_dir"] = ::testing::TempDir();
+
+    ResourceConfig config(
+        "rdk:component:audioout", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    // Write a small WAV at the speaker's native format into the asset dir
+    int num_samples = 4800;
+    std::vector<int16_t> test_samples(num_samples);
+    for (int i = 0; i < num_samples; i++) {
+        test_samples[i] = static_cast<int16_t>(i % 1000);
+    }
+    const auto wav_bytes = make_wav_pcm16(test_samples, sample_rate, num_channels);
+    const std::string wav_path = ::testing::TempDir() + "/play_file_test.wav";
+    std::ofstream out(wav_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(wav_bytes.data()), wav_bytes.size());
+    out.close();
+
+    // Stand in for the PortAudio callback so streaming never backpressures
+    std::atomic<bool> consumer_done{false};
+    std::thread consumer([&] {
+        while (!consumer_done.load()) {
+            speaker.audio_context_->playback_position.store(speaker.audio_context_->get_write_position());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    auto result = speaker.do_command(ProtoStruct{{"play_file", std::string("play_file_test.wav")}});
+
+    consumer_done.store(true);
+    consumer.join();
+
+    ASSERT_TRUE(result.count("played"));
+    EXPECT_EQ(speaker.audio_context_->get_write_position(), num_samples);
+
+    std::vector<int16_t> read_buffer(num_samples);
+    uint64_t read_pos = 0;
+    int samples_read = speaker.audio_context_->read_samples(read_buffer.data(), num_samples, read_pos);
+    ASSERT_EQ(samples_read, num_samples);
+    for (int i = 0; i < num_samples; i++) {
+        ASSERT_EQ(read_buffer[i], test_samples[i]);
+    }
+}
+
+TEST_F(SpeakerTest, PlayFileRequiresAssetDir) {
+    auto attributes = ProtoStruct{};
+    ResourceConfig config(
+        "rdk:component:speaker", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    EXPECT_THROW(speaker.do_command(ProtoStruct{{"play_file", std::string("clip.wav")}}), std::invalid_argument);
+}
+
+TEST_F(SpeakerTest, PlayFileRejectsPathTraversal) {
+    auto attributes = ProtoStruct{};
+    attributes["asset_dir"] = ::testing::TempDir();
+    ResourceConfig config(
+        "rdk:component:speaker", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    EXPECT_THROW(speaker.do_command(ProtoStruct{{"play_file", std::string("../etc/passwd")}}), std::invalid_argument);
+    EXPECT_THROW(speaker.do_command(ProtoStruct{{"play_file", std::string("/etc/passwd")}}), std::invalid_argument);
+}
+
+TEST_F(SpeakerTest, QueuedPlayReturnsImmediatelyAndCompletes) {
+    int sample_rate = 48000;
+    int num_channels = 2;
+
+    auto attributes = ProtoStruct{};
+    attributes["sample_rate"] = static_cast<double>(sample_rate);
+    attributes["num_channels"] = static_cast<double>(num_channels);
+
+    ResourceConfig config(
+        "rdk:component:audioout", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    int num_samples = 9600;
+    std::vector<uint8_t> audio_data(num_samples * sizeof(int16_t));
+    int16_t* samples = reinterpret_cast<int16_t*>(audio_data.data());
+    for (int i = 0; i < num_samples; i++) {
+        samples[i] = static_cast<int16_t>(i % 1000);
+    }
+
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, sample_rate, num_channels};
+    ProtoStruct extra{{"queued", true}};
+
+    // Returns without anyone advancing the playback position - the blocking
+    // path would hang here
+    speaker.play(audio_data, info, extra);
+
+    // Wait for the scheduler to write the item into the ring
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    std::string state;
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto status = speaker.do_command(ProtoStruct{{"play_status", 1.0}});
+        state = *status.at("state").get<std::string>();
+        if (state == "playing") {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(state, "playing");
+    EXPECT_EQ(speaker.audio_context_->get_write_position(), num_samples);
+
+    // Simulate the callback consuming everything, then wait for completion
+    speaker.audio_context_->playback_position.store(speaker.audio_context_->get_write_position());
+    auto result = speaker.do_command(ProtoStruct{{"wait_playback", 1.0}, {"timeout_ms", 5000.0}});
+    EXPECT_EQ(*result.at("state").get<std::string>(), "done");
+    EXPECT_FALSE(*result.at("timed_out").get<bool>());
+}
+
+TEST_F(SpeakerTest, StopCancelsQueuedPlayback) {
+    int sample_rate = 48000;
+    int num_channels = 2;
+
+    auto attributes = ProtoStruct{};
+    attributes["sample_rate"] = static_cast<double>(sample_rate);
+    attributes["num_channels"] = static_cast<double>(num_channels);
+
+    ResourceConfig config(
+        "rdk:component:audioout", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    int num_samples = 4800;
+    std::vector<uint8_t> audio_data(num_samples * sizeof(int16_t));
+
+    viam::sdk::audio_info info{viam::sdk::audio_codecs::PCM_16, sample_rate, num_channels};
+    ProtoStruct extra{{"queued", true}};
+    speaker.play(audio_data, info, extra);
+    speaker.play(audio_data, info, extra);
+
+    speaker.do_command(ProtoStruct{{"stop", true}});
+
+    // Both items end up stopped regardless of whether they were scheduled yet
+    for (double id = 1.0; id <= 2.0; id += 1.0) {
+        auto result = speaker.do_command(ProtoStruct{{"wait_playback", id}, {"timeout_ms", 5000.0}});
+        EXPECT_EQ(*result.at("state").get<std::string>(), "stopped");
+    }
+
+    auto queue = speaker.do_command(ProtoStruct{{"playback_queue", true}});
+    EXPECT_EQ(*queue.at("pending").get<double>(), 0.0);
+    EXPECT_EQ(*queue.at("in_flight").get<double>(), 0.0);
+}
+
+TEST_F(SpeakerTest, PlayStatusUnknownId) {
+    auto attributes = ProtoStruct{};
+    ResourceConfig config(
+        "rdk:component:speaker", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    auto result = speaker.do_command(ProtoStruct{{"play_status", 42.0}});
+    EXPECT_EQ(*result.at("state").get<std::string>(), "unknown");
+}
+
+TEST_F(SpeakerTest, ReconfigureStreamIrrelevantChangeKeepsStream) {
+    auto attributes = ProtoStruct{};
+    attributes["sample_rate"] = 48000.0;
+    attributes["num_channels"] = 2.0;
+    attributes["volume"] = 30.0;
+    ResourceConfig config(
+        "rdk:component:speaker", "", test_name_, attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+
+    Dependencies deps{};
+    speaker::Speaker speaker(deps, config, mock_pa_.get());
+
+    auto initial_context = speaker.audio_context_;
+    ASSERT_NE(initial_context, nullptr);
+    // Queue some unplayed audio - the fast path must not discard it
+    for (int i = 0; i < 100; i++) {
+        initial_context->write_sample(static_cast<int16_t>(i));
+    }
+
+    // Only the volume changed - the stream must not be touched
+    EXPECT_CALL(*mock_pa_, stopStream(::testing::_)).Times(0);
+    EXPECT_CALL(*mock_pa_, closeStream(::testing::_)).Times(0);
+    EXPECT_CALL(*mock_pa_, openStream(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_,
+                                      ::testing::_))
+        .Times(0);
+
+    auto new_attributes = attributes;
+    new_attributes["volume"] = 60.0;
+    ResourceConfig new_config(
+        "rdk:component:speaker", "", test_name_, new_attributes, "",
+        speaker::Speaker::model, LinkConfig{}, log_level::info);
+    EXPECT_NO_THROW(speaker.reconfigure(deps, new_config));
+
+    EXPECT_EQ(speaker.volume_, 60);
+
+    // Same context, unplayed audio intact
+    EXPECT_EQ(speaker.audio_context_, initial_context);
+    EXPECT_EQ(initial_context->get_write_position(), 100);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   ::testing::AddGlobalTestEnvironment(new test_utils::AudioTestEnvironment);
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "stream_supervisor.hpp"
+#include "test_utils.hpp"
+
+using namespace audio::supervision;
+
+namespace {
+
+uint64_t steady_now_ns() {
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+// Supervisor with a long sweep interval so tests drive sweeps via sweep_once()
+// and a short staleness threshold / backoff so they run fast
+StreamSupervisor make_test_supervisor() {
+    return StreamSupervisor(std::chrono::hours(1), std::chrono::milliseconds(10), std::chrono::milliseconds(50),
+                            std::chrono::milliseconds(200));
+}
+
+}  // namespace
+
+TEST(StreamSupervisorTest, RestartsStaleStream) {
+    auto supervisor = make_test_supervisor();
+    std::atomic<int> restarts{0};
+
+    // Last callback 100ms ago, threshold is 10ms
+    const uint64_t stale_cb = steady_now_ns() - 100'000'000ULL;
+    supervisor.register_stream("mic", [stale_cb] { return stale_cb; }, [&] { restarts++; });
+
+    supervisor.sweep_once();
+    EXPECT_EQ(restarts.load(), 1);
+}
+
+TEST(StreamSupervisorTest, HealthyStreamNotRestarted) {
+    auto supervisor = make_test_supervisor();
+    std::atomic<int> restarts{0};
+
+    supervisor.register_stream("mic", [] { return steady_now_ns(); }, [&] { restarts++; });
+
+    supervisor.sweep_once();
+    EXPECT_EQ(restarts.load(), 0);
+}
+
+TEST(StreamSupervisorTest, StreamWithoutFirstCallbackNotRestarted) {
+    auto supervisor = make_test_supervisor();
+    std::atomic<int> restarts{0};
+
+    // 0 means the stream is still starting - never treat it as stalled
+    supervisor.register_stream("mic", [] { return uint64_t{0}; }, [&] { restarts++; });
+
+    supervisor.sweep_once();
+    EXPECT_EQ(restarts.load(), 0);
+}
+
+TEST(StreamSupervisorTest, FailedRestartBacksOff) {
+    auto supervisor = make_test_supervisor();
+    std::atomic<int> attempts{0};
+
+    const uint64_t stale_cb = steady_now_ns() - 100'000'000ULL;
+    supervisor.register_stream("mic", [stale_cb] { return stale_cb; },
+                               [&] {
+                                   attempts++;
+                                   throw std::runtime_error("device gone");
+                               });
+
+    supervisor.sweep_once();
+    EXPECT_EQ(attempts.load(), 1);
+
+    // Still inside the 50ms backoff window - no new attempt
+    supervisor.sweep_once();
+    EXPECT_EQ(attempts.load(), 1);
+
+    // Past the backoff window - retries
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    supervisor.sweep_once();
+    EXPECT_EQ(attempts.load(), 2);
+}
+
+TEST(StreamSupervisorTest, UnregisteredStreamNotSwept) {
+    auto supervisor = make_test_supervisor();
+    std::atomic<int> restarts{0};
+
+    const uint64_t stale_cb = steady_now_ns() - 100'000'000ULL;
+    const auto id = supervisor.register_stream("mic", [stale_cb] { return stale_cb; }, [&] { restarts++; });
+    supervisor.unregister_stream(id);
+
+    supervisor.sweep_once();
+    EXPECT_EQ(restarts.load(), 0);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new test_utils::AudioTestEnvironment);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gmock/gmock.h>
+#include <cstring>
 #include <viam/sdk/common/instance.hpp>
 #include "../src/audio_stream.hpp"
 #include "../src/portaudio.hpp"
@@ -107,9 +108,8 @@ protected:
 // Helper function to clear an AudioBuffer - resets all samples and write position
 inline void ClearAudioBuffer(audio::AudioBuffer& buffer) {
     buffer.total_samples_written.store(0);
-    for (int i = 0; i < buffer.buffer_capacity; i++) {
-        buffer.audio_buffer[i].store(0);
-    }
+    buffer.total_samples_reserved.store(0);
+    std::memset(buffer.audio_buffer.get(), 0, buffer.buffer_capacity * sizeof(int16_t));
 }
 
 } // namespace test_utils